@@ -0,0 +1,381 @@
+/**
+ * Parse throughput benchmark
+ *
+ * Parses a generated corpus (see corpus.h), or the files given on the command
+ * line, with the full parser linked against libtree-sitter and reports:
+ *
+ *   - throughput in MB/s and p50/p99 per-file latency, per category
+ *   - peak resident set size
+ *   - the parse table dimensions, to catch grammar changes that blow them up
+ *   - time spent in the external scanner, broken down by returned token
+ *   - the peak number of GLR stack versions and the share of parse steps
+ *     taken while the stack was split, per category
+ *   - throughput of the directive summary (tree-sitter-razor-summary.h)
+ *     over the same files, for each scope
+ *
+ * The scanner breakdown and the stack version counts come from separate
+ * passes so that neither the timers nor the parser logger distort the
+ * throughput numbers.
+ *
+ * With -F, exits non-zero when any file of the given category needed more
+ * than one stack version, which the expression-dense "grid" category never
+ * should (see _razor_primary_expression in grammar.js).
+ *
+ * Usage: bench [-n iterations] [-F category] [file...]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "corpus.h"
+#include "profile.h"
+
+#include "tree_sitter/tree-sitter-razor-summary.h"
+
+#include <tree_sitter/api.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+
+const TSLanguage *tree_sitter_razor(void);
+
+typedef struct {
+    const char *name;
+    const char *category;
+    BenchBuffer source;
+} BenchFile;
+
+typedef struct {
+    BenchFile *contents;
+    uint32_t size;
+    uint32_t capacity;
+} BenchCorpus;
+
+static void corpus_add(BenchCorpus *corpus, const char *name, const char *category, BenchBuffer source) {
+    if (corpus->size == corpus->capacity) {
+        corpus->capacity = corpus->capacity ? corpus->capacity * 2 : 16;
+        corpus->contents = realloc(corpus->contents, corpus->capacity * sizeof(BenchFile));
+    }
+    corpus->contents[corpus->size++] = (BenchFile){name, category, source};
+}
+
+static void corpus_generate(BenchCorpus *corpus) {
+    for (unsigned i = 0; i < 40; i++) {
+        BenchBuffer source = {0};
+        generate_component(&source, i);
+        corpus_add(corpus, "Edit.razor", "component", source);
+    }
+    for (unsigned i = 0; i < 40; i++) {
+        BenchBuffer source = {0};
+        generate_imports(&source, i, 400);
+        corpus_add(corpus, "_Imports.razor", "imports", source);
+    }
+    for (unsigned i = 0; i < 4; i++) {
+        BenchBuffer source = {0};
+        generate_layout(&source, i, 5000);
+        corpus_add(corpus, "_Layout.cshtml", "layout", source);
+    }
+    for (unsigned i = 0; i < 10; i++) {
+        BenchBuffer source = {0};
+        generate_foreach_table(&source, i, 200);
+        corpus_add(corpus, "Orders.cshtml", "foreach", source);
+    }
+    for (unsigned i = 0; i < 10; i++) {
+        BenchBuffer source = {0};
+        generate_grid(&source, i, 200);
+        corpus_add(corpus, "Grid.razor", "grid", source);
+    }
+    for (unsigned i = 0; i < 10; i++) {
+        BenchBuffer source = {0};
+        generate_broken_layout(&source, i, 200);
+        corpus_add(corpus, "Broken.cshtml", "broken", source);
+    }
+    for (unsigned i = 0; i < 4; i++) {
+        BenchBuffer source = {0};
+        generate_script_page(&source, i, 256 << 10);
+        corpus_add(corpus, "Bundle.cshtml", "script", source);
+    }
+}
+
+static bool corpus_read(BenchCorpus *corpus, const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        perror(path);
+        return false;
+    }
+    BenchBuffer source = {0};
+    char chunk[1 << 16];
+    size_t length;
+    while ((length = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        buffer_reserve(&source, (uint32_t)length);
+        memcpy(source.contents + source.size, chunk, length);
+        source.size += (uint32_t)length;
+    }
+    fclose(file);
+    corpus_add(corpus, path, "file", source);
+    return true;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(double *sorted, uint32_t count, double fraction) {
+    if (count == 0) {
+        return 0;
+    }
+    uint32_t index = (uint32_t)(fraction * (double)(count - 1) + 0.5);
+    return sorted[index];
+}
+
+static void report_category(const BenchCorpus *corpus, const char *category, const double *latencies,
+                            unsigned iterations) {
+    uint32_t files = 0;
+    uint64_t bytes = 0;
+    uint32_t errors = 0;
+    double *samples = malloc(sizeof(double) * corpus->size * iterations + 1);
+    uint32_t sample_count = 0;
+    double total = 0;
+
+    for (uint32_t i = 0; i < corpus->size; i++) {
+        const BenchFile *file = &corpus->contents[i];
+        if (category && strcmp(file->category, category) != 0) {
+            continue;
+        }
+        files++;
+        bytes += file->source.size;
+        if (latencies[(size_t)i * (iterations + 1) + iterations] != 0) {
+            errors++;
+        }
+        for (unsigned j = 0; j < iterations; j++) {
+            double sample = latencies[(size_t)i * (iterations + 1) + j];
+            samples[sample_count++] = sample;
+            total += sample;
+        }
+    }
+
+    if (files > 0) {
+        qsort(samples, sample_count, sizeof(double), compare_doubles);
+        printf("%-12s %6u %10.1f %9.2f %9.3f %9.3f %7u\n", category ? category : "total", files,
+               (double)bytes / 1024.0, (double)bytes * iterations / total / 1e6,
+               percentile(samples, sample_count, 0.50) * 1e3, percentile(samples, sample_count, 0.99) * 1e3,
+               errors);
+    }
+    free(samples);
+}
+
+static void report_scanner_profile(void) {
+    uint64_t total = 0;
+    for (unsigned i = 0; i < razor_profile_bucket_count(); i++) {
+        total += razor_profile_bucket(i)->nanoseconds;
+    }
+
+    printf("\n%-30s %10s %10s %7s %8s\n", "external token", "calls", "ms", "%", "ns/call");
+    for (unsigned i = 0; i < razor_profile_bucket_count(); i++) {
+        const TokenProfile *profile = razor_profile_bucket(i);
+        if (profile->calls == 0) {
+            continue;
+        }
+        printf("%-30s %10llu %10.2f %6.1f%% %8.1f\n", razor_profile_bucket_name(i),
+               (unsigned long long)profile->calls, (double)profile->nanoseconds / 1e6,
+               total ? 100.0 * (double)profile->nanoseconds / (double)total : 0.0,
+               (double)profile->nanoseconds / (double)profile->calls);
+    }
+}
+
+typedef struct {
+    uint32_t peak_versions;
+    uint64_t steps;
+    uint64_t forked_steps;
+} ForkStats;
+
+// The parser logs one "process version:N, version_count:M, ..." line for
+// every stack version it advances, so counting those lines measures how
+// much work went into versions that GLR kept alive side by side
+static void log_fork_stats(void *payload, TSLogType type, const char *message) {
+    ForkStats *stats = payload;
+    const char *count = type == TSLogTypeParse ? strstr(message, "version_count:") : NULL;
+    if (!count) {
+        return;
+    }
+    uint32_t versions = (uint32_t)strtoul(count + strlen("version_count:"), NULL, 10);
+    if (versions > stats->peak_versions) {
+        stats->peak_versions = versions;
+    }
+    stats->steps++;
+    if (versions > 1) {
+        stats->forked_steps++;
+    }
+}
+
+// The stats of the files of `category`, or of every file if it is NULL
+static ForkStats total_fork_stats(const BenchCorpus *corpus, const char *category, const ForkStats *stats,
+                                  uint32_t *files) {
+    ForkStats total = {0};
+    *files = 0;
+    for (uint32_t i = 0; i < corpus->size; i++) {
+        if (category && strcmp(corpus->contents[i].category, category) != 0) {
+            continue;
+        }
+        (*files)++;
+        if (stats[i].peak_versions > total.peak_versions) {
+            total.peak_versions = stats[i].peak_versions;
+        }
+        total.steps += stats[i].steps;
+        total.forked_steps += stats[i].forked_steps;
+    }
+    return total;
+}
+
+static void report_fork_stats(const BenchCorpus *corpus, const char *category, const ForkStats *stats) {
+    uint32_t files;
+    ForkStats total = total_fork_stats(corpus, category, stats, &files);
+    if (files > 0) {
+        printf("%-12s %13u %12llu %9.2f%%\n", category ? category : "total", total.peak_versions,
+               (unsigned long long)total.steps,
+               total.steps ? 100.0 * (double)total.forked_steps / (double)total.steps : 0.0);
+    }
+}
+
+// Summarize every file `iterations` times in `scope`, reporting the
+// directives found in one pass and the throughput over all of them
+static void report_summary(TSParser *parser, const BenchCorpus *corpus, TSRazorSummaryScope scope,
+                           unsigned iterations) {
+    uint64_t bytes = 0;
+    uint32_t directives = 0;
+    double start = now_seconds();
+    for (unsigned j = 0; j < iterations; j++) {
+        for (uint32_t i = 0; i < corpus->size; i++) {
+            const BenchFile *file = &corpus->contents[i];
+            TSRazorSummary summary;
+            if (tree_sitter_razor_summarize(parser, file->source.contents, file->source.size, scope, &summary)) {
+                directives += j == 0 ? summary.directive_count : 0;
+                tree_sitter_razor_summary_delete(&summary);
+            }
+            bytes += file->source.size;
+        }
+    }
+    double elapsed = now_seconds() - start;
+    printf("%-12s %10u %9.2f\n", scope == TSRazorSummaryLeading ? "leading" : "document", directives,
+           (double)bytes / elapsed / 1e6);
+}
+
+static long peak_rss_kilobytes(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+int main(int argc, char **argv) {
+    unsigned iterations = 5;
+    const char *fork_free_category = NULL;
+    BenchCorpus corpus = {0};
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            iterations = (unsigned)strtoul(argv[++i], NULL, 10);
+            if (iterations == 0) {
+                iterations = 1;
+            }
+        } else if (strcmp(argv[i], "-F") == 0 && i + 1 < argc) {
+            fork_free_category = argv[++i];
+        } else if (!corpus_read(&corpus, argv[i])) {
+            return EXIT_FAILURE;
+        }
+    }
+    if (corpus.size == 0) {
+        corpus_generate(&corpus);
+    }
+
+    const TSLanguage *language = tree_sitter_razor();
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, language);
+
+    // One row per file: `iterations` latency samples followed by an error flag
+    double *latencies = calloc((size_t)corpus.size * (iterations + 1), sizeof(double));
+
+    for (unsigned j = 0; j < iterations; j++) {
+        for (uint32_t i = 0; i < corpus.size; i++) {
+            const BenchFile *file = &corpus.contents[i];
+            double start = now_seconds();
+            TSTree *tree = ts_parser_parse_string(parser, NULL, file->source.contents, file->source.size);
+            double elapsed = now_seconds() - start;
+            latencies[(size_t)i * (iterations + 1) + j] = elapsed;
+            if (j == 0 && ts_node_has_error(ts_tree_root_node(tree))) {
+                latencies[(size_t)i * (iterations + 1) + iterations] = 1;
+            }
+            ts_tree_delete(tree);
+        }
+    }
+
+    printf("language: %u states, %u symbols, %u fields\n\n", ts_language_state_count(language),
+           ts_language_symbol_count(language), ts_language_field_count(language));
+    printf("%-12s %6s %10s %9s %9s %9s %7s\n", "category", "files", "KB", "MB/s", "p50 ms", "p99 ms", "errors");
+
+    const char *categories[] = {"component", "imports", "layout", "foreach", "grid", "broken", "script", "file"};
+    for (unsigned i = 0; i < sizeof(categories) / sizeof(categories[0]); i++) {
+        report_category(&corpus, categories[i], latencies, iterations);
+    }
+    report_category(&corpus, NULL, latencies, iterations);
+    printf("\npeak RSS: %.1f MB\n", (double)peak_rss_kilobytes() / 1024.0);
+
+    razor_profile_reset();
+    razor_profile_enabled = true;
+    for (uint32_t i = 0; i < corpus.size; i++) {
+        const BenchFile *file = &corpus.contents[i];
+        ts_tree_delete(ts_parser_parse_string(parser, NULL, file->source.contents, file->source.size));
+    }
+    razor_profile_enabled = false;
+    report_scanner_profile();
+
+    ForkStats *fork_stats = calloc(corpus.size, sizeof(ForkStats));
+    for (uint32_t i = 0; i < corpus.size; i++) {
+        const BenchFile *file = &corpus.contents[i];
+        ts_parser_set_logger(parser, (TSLogger){&fork_stats[i], log_fork_stats});
+        ts_tree_delete(ts_parser_parse_string(parser, NULL, file->source.contents, file->source.size));
+    }
+    ts_parser_set_logger(parser, (TSLogger){NULL, NULL});
+
+    printf("\n%-12s %13s %12s %10s\n", "category", "peak versions", "steps", "forked");
+    for (unsigned i = 0; i < sizeof(categories) / sizeof(categories[0]); i++) {
+        report_fork_stats(&corpus, categories[i], fork_stats);
+    }
+    report_fork_stats(&corpus, NULL, fork_stats);
+    uint32_t fork_free_files = 0;
+    ForkStats fork_free = {0};
+    if (fork_free_category) {
+        fork_free = total_fork_stats(&corpus, fork_free_category, fork_stats, &fork_free_files);
+    }
+    free(fork_stats);
+
+    printf("\n%-12s %10s %9s\n", "summary", "directives", "MB/s");
+    report_summary(parser, &corpus, TSRazorSummaryLeading, iterations);
+    report_summary(parser, &corpus, TSRazorSummaryDocument, iterations);
+
+    free(latencies);
+    for (uint32_t i = 0; i < corpus.size; i++) {
+        buffer_delete(&corpus.contents[i].source);
+    }
+    free(corpus.contents);
+    ts_parser_delete(parser);
+
+    if (fork_free_category && (fork_free_files == 0 || fork_free.peak_versions > 1)) {
+        fprintf(stderr, "%s: %u files, peak of %u stack versions; expected one version\n", fork_free_category,
+                fork_free_files, fork_free.peak_versions);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,65 @@
+#!/bin/sh
+#
+# Parse table budget check
+#
+# Fails when the generated parser grows past the limits below. Most of the
+# table comes from the inherited C# grammar, so a small change to grammar.js
+# can add thousands of states; this keeps that from going unnoticed. When a
+# change shrinks the table, lower the limits to the new numbers so it cannot
+# quietly grow back.
+#
+# The counts only mean something for a parser.c generated from the
+# grammar.json next to it, so it also fails when the two have a different
+# number of external tokens, as a parser.c left behind by a grammar change
+# does.
+#
+# Usage: check-budget.sh [path/to/parser.c]
+
+set -eu
+
+PARSER=${1:-src/parser.c}
+GRAMMAR=$(dirname "$PARSER")/grammar.json
+
+# These are still the counts of the parser.c generated before the pruned C#
+# rules and the shared block contents in grammar.js, which should only be
+# smaller. Regenerate and lower them to the new counts.
+MAX_STATE_COUNT=23336
+MAX_LARGE_STATE_COUNT=9989
+MAX_SYMBOL_COUNT=642
+MAX_PARSER_BYTES=69560583
+
+status=0
+
+define() {
+    sed -n "s/^#define $1 \([0-9]*\)$/\1/p" "$PARSER"
+}
+
+check() {
+    if [ -z "$2" ]; then
+        echo "$1: not found in $PARSER"
+        status=1
+    elif [ "$2" -gt "$3" ]; then
+        echo "$1: $2 exceeds budget of $3"
+        status=1
+    else
+        echo "$1: $2 (budget $3)"
+    fi
+}
+
+# One "type" per entry of the top-level externals array
+externals=$(awk '/^  "externals": \[/ { inside = 1; next }
+                 inside && /^  \]/ { inside = 0 }
+                 inside && /"type":/ { count++ }
+                 END { print count + 0 }' "$GRAMMAR")
+tokens=$(define EXTERNAL_TOKEN_COUNT)
+if [ "$tokens" != "$externals" ]; then
+    echo "EXTERNAL_TOKEN_COUNT: ${tokens:-none} in $PARSER, but $GRAMMAR has $externals externals; run tree-sitter generate"
+    status=1
+fi
+
+check STATE_COUNT "$(define STATE_COUNT)" "$MAX_STATE_COUNT"
+check LARGE_STATE_COUNT "$(define LARGE_STATE_COUNT)" "$MAX_LARGE_STATE_COUNT"
+check SYMBOL_COUNT "$(define SYMBOL_COUNT)" "$MAX_SYMBOL_COUNT"
+check "parser.c bytes" "$(wc -c < "$PARSER" | tr -d ' ')" "$MAX_PARSER_BYTES"
+
+exit $status
@@ -0,0 +1,210 @@
+/**
+ * Generated benchmark corpus
+ *
+ * Deterministic .razor/.cshtml documents modelled on what real projects
+ * contain: small Blazor components, long layouts, @foreach-heavy tables,
+ * expression-dense grids, pages carrying large inline scripts, and layouts
+ * left broken mid-edit. The seed varies identifiers and sizes
+ * so that files within a category are not byte-identical.
+ */
+
+#ifndef TREE_SITTER_RAZOR_BENCH_CORPUS_H_
+#define TREE_SITTER_RAZOR_BENCH_CORPUS_H_
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    char *contents;
+    uint32_t size;
+    uint32_t capacity;
+} BenchBuffer;
+
+static inline void buffer_reserve(BenchBuffer *buffer, uint32_t additional) {
+    if (buffer->size + additional + 1 > buffer->capacity) {
+        buffer->capacity = (buffer->size + additional + 1) * 2;
+        buffer->contents = realloc(buffer->contents, buffer->capacity);
+    }
+}
+
+static inline void buffer_append(BenchBuffer *buffer, const char *text) {
+    uint32_t length = (uint32_t)strlen(text);
+    buffer_reserve(buffer, length);
+    memcpy(buffer->contents + buffer->size, text, length + 1);
+    buffer->size += length;
+}
+
+static inline void buffer_appendf(BenchBuffer *buffer, const char *format, ...) {
+    char line[512];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (length > 0) {
+        buffer_append(buffer, line);
+    }
+}
+
+static inline void buffer_delete(BenchBuffer *buffer) {
+    free(buffer->contents);
+    buffer->contents = NULL;
+    buffer->size = buffer->capacity = 0;
+}
+
+// Blazor component: directives, bound inputs, a conditional and an @code block
+static inline void generate_component(BenchBuffer *buffer, unsigned seed) {
+    buffer_appendf(buffer, "@page \"/items/{Id:int}/edit%u\"\n", seed);
+    buffer_append(buffer, "@using System.ComponentModel.DataAnnotations\n");
+    buffer_appendf(buffer, "@inject IItemService Items%u\n", seed);
+    buffer_append(buffer, "@inject NavigationManager Navigation\n\n");
+    buffer_appendf(buffer, "<PageTitle>Edit item %u</PageTitle>\n\n", seed);
+    buffer_append(buffer, "<h3>Edit</h3>\n\n");
+    buffer_append(buffer, "@if (item is null)\n{\n    <p><em>Loading...</em></p>\n}\nelse\n{\n");
+    buffer_append(buffer, "    <EditForm Model=\"@item\" OnValidSubmit=\"@Save\">\n");
+    buffer_append(buffer, "        <DataAnnotationsValidator />\n");
+    for (unsigned i = 0; i < 3 + seed % 5; i++) {
+        buffer_appendf(buffer, "        <div class=\"mb-3\">\n"
+                               "            <label for=\"field%u\">Field %u</label>\n"
+                               "            <InputText id=\"field%u\" @bind-Value=\"item.Field%u\" />\n"
+                               "        </div>\n",
+                       i, i, i, i);
+    }
+    buffer_append(buffer, "        <button type=\"submit\" class=\"btn btn-primary\" @onclick=\"Save\">Save</button>\n");
+    buffer_append(buffer, "    </EditForm>\n}\n\n");
+    buffer_append(buffer, "@code {\n    [Parameter] public int Id { get; set; }\n\n");
+    buffer_append(buffer, "    private Item? item;\n\n");
+    buffer_append(buffer, "    protected override async Task OnInitializedAsync()\n    {\n"
+                          "        item = await Items.GetAsync(Id);\n    }\n\n");
+    buffer_append(buffer, "    private async Task Save()\n    {\n"
+                          "        await Items.UpdateAsync(item!);\n"
+                          "        Navigation.NavigateTo(\"/items\");\n    }\n}\n");
+}
+
+// _Imports.razor of roughly `lines` lines: nothing but directives, one per line
+static inline void generate_imports(BenchBuffer *buffer, unsigned seed, unsigned lines) {
+    for (unsigned i = 0; i < lines; i += 8) {
+        buffer_appendf(buffer, "@using Contoso.Module%u\n", seed + i);
+        buffer_appendf(buffer, "@using Contoso.Module%u.Components\n", seed + i);
+        buffer_appendf(buffer, "@namespace Contoso.Module%u.Pages\n", seed + i);
+        buffer_appendf(buffer, "@inject IStringLocalizer<Resource%u> L%u\n", i, i);
+        buffer_append(buffer, "@attribute [Authorize]\n");
+        buffer_append(buffer, "@layout MainLayout\n");
+        buffer_append(buffer, "@implements IDisposable\n");
+        buffer_append(buffer, "@addTagHelper *, Microsoft.AspNetCore.Mvc.TagHelpers\n");
+    }
+}
+
+// MVC layout of roughly `lines` lines: head, navigation, prose sections
+static inline void generate_layout(BenchBuffer *buffer, unsigned seed, unsigned lines) {
+    buffer_append(buffer, "<!DOCTYPE html>\n<html lang=\"en\">\n<head>\n");
+    buffer_append(buffer, "    <meta charset=\"utf-8\" />\n");
+    buffer_append(buffer, "    <meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\" />\n");
+    buffer_append(buffer, "    <title>@ViewData[\"Title\"] - Contoso</title>\n");
+    buffer_append(buffer, "    <link rel=\"stylesheet\" href=\"~/lib/bootstrap/dist/css/bootstrap.min.css\" />\n");
+    buffer_append(buffer, "</head>\n<body>\n    <header>\n        <nav class=\"navbar\">\n            <ul>\n");
+
+    unsigned line = 12;
+    for (unsigned i = 0; i < 8; i++, line += 3) {
+        buffer_appendf(buffer, "                <li class=\"nav-item\">\n"
+                               "                    <a class=\"nav-link\" href=\"/section%u\">Section %u</a>\n"
+                               "                </li>\n",
+                       i, i);
+    }
+    buffer_append(buffer, "            </ul>\n        </nav>\n    </header>\n    <main role=\"main\" class=\"pb-3\">\n");
+
+    for (unsigned i = 0; line < lines; i++, line += 12) {
+        buffer_appendf(buffer, "        <section id=\"s%u\">\n", i);
+        buffer_appendf(buffer, "            <h2>@Localizer[\"Heading%u\"]</h2>\n", (seed + i) % 50);
+        buffer_append(buffer, "            <p>\n"
+                              "                Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod\n"
+                              "                tempor incididunt ut labore et dolore magna aliqua, contact support@contoso.com\n"
+                              "                for details. Ut enim ad minim veniam, quis nostrud exercitation.\n"
+                              "            </p>\n");
+        buffer_appendf(buffer, "            @if (User.Identity?.IsAuthenticated == true)\n            {\n"
+                               "                <p>Signed in as @User.Identity.Name (@Model.Visits%u visits)</p>\n"
+                               "            }\n",
+                       i % 7);
+        buffer_append(buffer, "            <!-- end of section -->\n        </section>\n");
+    }
+
+    buffer_append(buffer, "        @RenderBody()\n    </main>\n");
+    buffer_append(buffer, "    <footer class=\"border-top footer\">&copy; 2024 - Contoso</footer>\n");
+    buffer_append(buffer, "    @await RenderSectionAsync(\"Scripts\", required: false)\n</body>\n</html>\n");
+}
+
+// Data grid built from `loops` @foreach blocks with per-cell expressions
+static inline void generate_foreach_table(BenchBuffer *buffer, unsigned seed, unsigned loops) {
+    buffer_append(buffer, "@model IEnumerable<OrderViewModel>\n");
+    buffer_append(buffer, "@{\n    ViewData[\"Title\"] = \"Orders\";\n    var total = 0m;\n}\n\n");
+    buffer_append(buffer, "<table class=\"table\">\n    <thead>\n        <tr>\n");
+    for (unsigned i = 0; i < 6; i++) {
+        buffer_appendf(buffer, "            <th>Column %u</th>\n", i);
+    }
+    buffer_append(buffer, "        </tr>\n    </thead>\n    <tbody>\n");
+    for (unsigned group = 0; group < loops; group++) {
+        buffer_appendf(buffer, "        @foreach (var order in Model.Where(o => o.Group == %u))\n        {\n", seed + group);
+        buffer_append(buffer, "            total += order.Amount;\n");
+        buffer_append(buffer, "            <tr class=\"@(order.IsLate ? \"late\" : \"\")\">\n"
+                              "                <td>@order.Id</td>\n"
+                              "                <td>@order.Customer.Name</td>\n"
+                              "                <td>@order.Lines[0].Product</td>\n"
+                              "                <td>@order.Placed.ToString(\"d\")</td>\n"
+                              "                <td>@(order.Amount * 1.2m)</td>\n"
+                              "                <td><a href=\"/orders/@order.Id\">Details</a></td>\n"
+                              "            </tr>\n");
+        buffer_append(buffer, "        }\n");
+    }
+    buffer_append(buffer, "    </tbody>\n</table>\n<p>Total: @total</p>\n");
+}
+
+// Blazor grid of `rows` rows whose cells are long implicit expression chains,
+// many of them followed by text that starts like a chain continuation
+static inline void generate_grid(BenchBuffer *buffer, unsigned seed, unsigned rows) {
+    buffer_append(buffer, "@page \"/grid\"\n@inject IGridService Grid\n\n<table class=\"grid\">\n");
+    for (unsigned row = 0; row < rows; row++) {
+        unsigned column = (seed + row) % 8;
+        buffer_appendf(buffer, "    <tr class=\"@Model.Rows[%u].CssClass\">\n", row);
+        buffer_appendf(buffer, "        <td>@Model.Items[%u].Name</td>\n", row);
+        buffer_appendf(buffer, "        <td>@Model.Items[%u].Cells[%u].Format(\"n2\", Culture)</td>\n", row, column);
+        buffer_appendf(buffer, "        <td>@Grid.Lookup(Model.Items[%u].Id)?.Owner.DisplayName</td>\n", row);
+        buffer_appendf(buffer, "        <td>@Model.Items[%u].Total.</td>\n", row);
+        buffer_appendf(buffer, "        <td>(@Model.Items[%u].Count) [@Model.Items[%u].Unit]</td>\n", row, row);
+        buffer_append(buffer, "    </tr>\n");
+    }
+    buffer_append(buffer, "</table>\n");
+}
+
+// Layout as it looks while being edited: an @{ block missing its closing
+// brace near the top and an unclosed <div>, then `sections` sections of
+// ordinary markup and an @code block, which error recovery has to get back to
+static inline void generate_broken_layout(BenchBuffer *buffer, unsigned seed, unsigned sections) {
+    buffer_append(buffer, "@{\n    ViewData[\"Title\"] = \"Home\";\n    var user = Model.User;\n\n");
+    buffer_append(buffer, "<!DOCTYPE html>\n<html>\n<body>\n<div class=\"page\">\n");
+    for (unsigned i = 0; i < sections; i++) {
+        buffer_appendf(buffer, "@section Block%u {\n", seed + i);
+        buffer_appendf(buffer, "    <p>Paragraph %u for @user.Name, with @Model.Count items in it.</p>\n", i);
+        buffer_append(buffer, "    <ul>\n        <li><a href=\"/\">Home</a></li>\n        <li>About</li>\n    </ul>\n}\n");
+        buffer_append(buffer, "Text between sections, as a layout has.\n");
+    }
+    buffer_append(buffer, "</body>\n</html>\n");
+    buffer_appendf(buffer, "@code {\n    private int count = %u;\n}\n", seed);
+}
+
+// Page with an inline bundle of roughly `script_size` bytes
+static inline void generate_script_page(BenchBuffer *buffer, unsigned seed, uint32_t script_size) {
+    buffer_append(buffer, "@{\n    Layout = \"_Layout\";\n}\n<div id=\"app\"></div>\n");
+    buffer_append(buffer, "<script type=\"text/javascript\">\n");
+    uint32_t end = buffer->size + script_size;
+    for (unsigned i = 0; buffer->size < end; i++) {
+        buffer_appendf(buffer, "function f%u(a,b){if(a<b&&b.length<%u){el.innerHTML=\"<div class='x'>\"+a+\"</div>\";}"
+                               "return a<=b?a:b;}\n",
+                       i, (seed + i) % 97);
+    }
+    buffer_append(buffer, "</script>\n");
+    buffer_append(buffer, "<style>\n    #app { min-height: 100vh; }\n</style>\n");
+}
+
+#endif // TREE_SITTER_RAZOR_BENCH_CORPUS_H_
@@ -0,0 +1,269 @@
+/**
+ * Incremental reparse benchmark and subtree reuse check
+ *
+ * Replays editing sessions as a language server sees them: text typed one
+ * character at a time into a generated document (see corpus.h), with
+ * ts_tree_edit and a reparse against the previous tree after every
+ * keystroke. For each session it reports the reparse latency and the
+ * number of bytes the lexer went over again, taken from the sizes of the
+ * tokens the parser logs as lexed.
+ *
+ * Scanner state that leaks across tokens, or a lookahead that reaches too
+ * far, shows up as a keystroke that re-lexes far more than the tokens
+ * around it, so the run fails if any keystroke re-lexes more than the
+ * session's budget. It also fails if the tree after the last keystroke is
+ * not the one a fresh parse of the same text gives, for the sessions whose
+ * document parses without errors.
+ *
+ * Usage: edit_bench [-b max re-lexed bytes per keystroke]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "corpus.h"
+
+#include <tree_sitter/api.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+const TSLanguage *tree_sitter_razor(void);
+
+// Default budget per keystroke. Every document is at least 20 times larger,
+// so losing reuse across the document cannot stay under it.
+#define DEFAULT_RELEX_BUDGET 4096
+
+typedef struct {
+    const char *name;
+    void (*generate)(BenchBuffer *buffer);
+    // Typing starts just past `occurrence` of `anchor`, counted from 0
+    const char *anchor;
+    unsigned occurrence;
+    const char *typed;
+    // The document does not parse cleanly, so only the budget is checked:
+    // error recovery may build a different tree from an edited one
+    bool has_errors;
+} EditSession;
+
+static void session_foreach(BenchBuffer *buffer) { generate_foreach_table(buffer, 0, 200); }
+
+static void session_layout(BenchBuffer *buffer) { generate_layout(buffer, 0, 5000); }
+
+static void session_code(BenchBuffer *buffer) {
+    generate_component(buffer, 0);
+    generate_foreach_table(buffer, 1, 200);
+}
+
+static void session_script(BenchBuffer *buffer) { generate_script_page(buffer, 0, 256 * 1024); }
+
+// The same page while its </script> has not been typed yet
+static void session_unclosed_script(BenchBuffer *buffer) {
+    generate_script_page(buffer, 0, 256 * 1024);
+    char *end_tag = strstr(buffer->contents, "</script>");
+    buffer->size = (uint32_t)(end_tag - buffer->contents);
+    buffer->contents[buffer->size] = '\0';
+}
+
+// A long paragraph with an email address on its first line
+static void session_email(BenchBuffer *buffer) {
+    buffer_append(buffer, "<div class=\"terms\">\n    Questions go to legal@contoso.com, in writing\n");
+    for (unsigned i = 0; i < 400; i++) {
+        buffer_appendf(buffer, "    clause %u applies to every order placed under these terms and conditions\n", i);
+    }
+    buffer_append(buffer, "</div>\n");
+}
+
+static const EditSession SESSIONS[] = {
+    // A new cell in the middle of a long @foreach table
+    {"foreach", session_foreach, "<td>@order.Id</td>\n", 100, "                <td>@order.Note</td>\n", false},
+    // An attribute added to a tag in a long layout
+    {"attribute", session_layout, "<section id=\"s200\"", 0, " class=\"highlight\" data-index=\"@i\"", false},
+    // Prose typed on the line after the closing brace of an @if, where text
+    // checks for else/catch/finally and reads "else" on the way to
+    // "elsewhere"
+    {"prose", session_layout, "            }\n", 200, "            elsewhere, catching up finally\n", false},
+    // A field and a method added to the @code block of a component followed
+    // by a long table
+    {"code", session_code, "private Item? item;\n", 0,
+     "    private int clicks;\n\n    private void Click() => clicks++;\n", false},
+    // A function added in the middle of a 256KB inline bundle, which the
+    // scanner hands out in chunks rather than as one token
+    {"script", session_script, "return a<=b?a:b;}\n", 1000, "function added(a){return a+1;}\n", false},
+    // The same with the end tag missing, where raw text runs to the end of
+    // the file
+    {"unclosed", session_unclosed_script, "return a<=b?a:b;}\n", 1000, "function added(a){return a+1;}\n",
+     true},
+    // Text typed far past an email address in the same run of text, which
+    // the literal @ token would otherwise extend over
+    {"email", session_email, "clause 200 applies", 0, " only", false},
+};
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Find `occurrence` of `anchor` and return the offset just past it
+static bool find_anchor(const BenchBuffer *buffer, const char *anchor, unsigned occurrence, uint32_t *offset) {
+    const char *found = buffer->contents;
+    for (unsigned i = 0;; i++, found++) {
+        found = strstr(found, anchor);
+        if (!found) {
+            return false;
+        }
+        if (i == occurrence) {
+            *offset = (uint32_t)(found - buffer->contents) + (uint32_t)strlen(anchor);
+            return true;
+        }
+    }
+}
+
+static TSPoint point_at(const BenchBuffer *buffer, uint32_t offset) {
+    TSPoint point = {0, 0};
+    for (uint32_t i = 0; i < offset; i++) {
+        if (buffer->contents[i] == '\n') {
+            point.row++;
+            point.column = 0;
+        } else {
+            point.column++;
+        }
+    }
+    return point;
+}
+
+// Insert one character at `offset`, describing the change for ts_tree_edit
+static TSInputEdit insert_character(BenchBuffer *buffer, uint32_t offset, char c) {
+    TSPoint start = point_at(buffer, offset);
+    buffer_reserve(buffer, 1);
+    memmove(buffer->contents + offset + 1, buffer->contents + offset, buffer->size - offset + 1);
+    buffer->contents[offset] = c;
+    buffer->size++;
+
+    TSPoint end = c == '\n' ? (TSPoint){start.row + 1, 0} : (TSPoint){start.row, start.column + 1};
+    return (TSInputEdit){
+        .start_byte = offset,
+        .old_end_byte = offset,
+        .new_end_byte = offset + 1,
+        .start_point = start,
+        .old_end_point = start,
+        .new_end_point = end,
+    };
+}
+
+// The parser logs a "lexed_lookahead sym:..., size:N" line for every token
+// it lexes, N counting the whitespace in front of the token as well, while
+// reused subtrees are never lexed again
+static void log_lexed_bytes(void *payload, TSLogType type, const char *message) {
+    uint64_t *bytes = payload;
+    if (type != TSLogTypeParse || strncmp(message, "lexed_lookahead", strlen("lexed_lookahead")) != 0) {
+        return;
+    }
+    const char *size = strstr(message, ", size:");
+    if (size) {
+        *bytes += strtoul(size + strlen(", size:"), NULL, 10);
+    }
+}
+
+static bool run_session(TSParser *parser, const EditSession *session, uint64_t budget) {
+    BenchBuffer buffer = {0};
+    session->generate(&buffer);
+    uint32_t offset;
+    if (!find_anchor(&buffer, session->anchor, session->occurrence, &offset)) {
+        fprintf(stderr, "%s: anchor not found in the generated document\n", session->name);
+        buffer_delete(&buffer);
+        return false;
+    }
+
+    uint32_t keystrokes = (uint32_t)strlen(session->typed);
+    double *latencies = malloc(keystrokes * sizeof(double));
+    uint64_t total_relexed = 0;
+    uint64_t max_relexed = 0;
+    uint32_t over_budget = 0;
+
+    TSTree *tree = ts_parser_parse_string(parser, NULL, buffer.contents, buffer.size);
+    for (uint32_t i = 0; i < keystrokes; i++) {
+        TSInputEdit edit = insert_character(&buffer, offset + i, session->typed[i]);
+        ts_tree_edit(tree, &edit);
+
+        // Timed without the logger, then parsed again from the same edited
+        // tree with it to count what was lexed
+        double start = now_seconds();
+        TSTree *reparsed = ts_parser_parse_string(parser, tree, buffer.contents, buffer.size);
+        latencies[i] = now_seconds() - start;
+
+        uint64_t relexed = 0;
+        ts_parser_set_logger(parser, (TSLogger){&relexed, log_lexed_bytes});
+        ts_tree_delete(ts_parser_parse_string(parser, tree, buffer.contents, buffer.size));
+        ts_parser_set_logger(parser, (TSLogger){NULL, NULL});
+
+        total_relexed += relexed;
+        if (relexed > max_relexed) {
+            max_relexed = relexed;
+        }
+        if (relexed > budget) {
+            over_budget++;
+        }
+        ts_tree_delete(tree);
+        tree = reparsed;
+    }
+
+    double start = now_seconds();
+    TSTree *fresh = ts_parser_parse_string(parser, NULL, buffer.contents, buffer.size);
+    double full = now_seconds() - start;
+    char *incremental_string = ts_node_string(ts_tree_root_node(tree));
+    char *fresh_string = ts_node_string(ts_tree_root_node(fresh));
+    bool same_tree = session->has_errors || strcmp(incremental_string, fresh_string) == 0;
+    free(incremental_string);
+    free(fresh_string);
+    ts_tree_delete(fresh);
+    ts_tree_delete(tree);
+
+    qsort(latencies, keystrokes, sizeof(double), compare_doubles);
+    printf("%-10s %8u %9.1f %9.3f %9.3f %9.3f %9.0f %9llu\n", session->name, keystrokes,
+           (double)buffer.size / 1024.0, latencies[keystrokes / 2] * 1e3, latencies[keystrokes - 1] * 1e3,
+           full * 1e3, (double)total_relexed / keystrokes, (unsigned long long)max_relexed);
+    if (over_budget > 0) {
+        fprintf(stderr, "%s: %u of %u keystrokes re-lexed more than %llu bytes\n", session->name, over_budget,
+                keystrokes, (unsigned long long)budget);
+    }
+    if (!same_tree) {
+        fprintf(stderr, "%s: the incrementally parsed tree differs from a fresh parse\n", session->name);
+    }
+
+    free(latencies);
+    buffer_delete(&buffer);
+    return over_budget == 0 && same_tree;
+}
+
+int main(int argc, char **argv) {
+    uint64_t budget = DEFAULT_RELEX_BUDGET;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            budget = strtoull(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "usage: %s [-b max re-lexed bytes per keystroke]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_razor());
+
+    printf("%-10s %8s %9s %9s %9s %9s %9s %9s\n", "session", "keys", "KB", "p50 ms", "max ms", "full ms",
+           "mean lex", "max lex");
+    bool ok = true;
+    for (unsigned i = 0; i < sizeof(SESSIONS) / sizeof(SESSIONS[0]); i++) {
+        ok &= run_session(parser, &SESSIONS[i], budget);
+    }
+
+    ts_parser_delete(parser);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
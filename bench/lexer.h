@@ -0,0 +1,134 @@
+/**
+ * In-memory TSLexer for driving the external scanner directly
+ *
+ * Implements just enough of tree-sitter's lexer contract (advance, mark_end,
+ * get_column, eof) over a UTF-8 buffer so the scanner can be exercised and
+ * timed without libtree-sitter or the generated parser. Every callback is
+ * counted, which makes it easy to see how many characters a token costs.
+ */
+
+#ifndef TREE_SITTER_RAZOR_BENCH_LEXER_H_
+#define TREE_SITTER_RAZOR_BENCH_LEXER_H_
+
+#include "tree_sitter/parser.h"
+
+#include <stdint.h>
+#include <string.h>
+
+typedef struct {
+    TSLexer base;
+    const uint8_t *input;
+    uint32_t length;
+    uint32_t position;      // Byte offset of the lookahead character
+    uint32_t lookahead_size;
+    uint32_t token_start;   // Byte offset of the token (after skipped characters)
+    uint32_t token_end;     // Byte offset recorded by the last mark_end
+    bool did_mark_end;
+    uint64_t advance_count;
+    uint64_t mark_end_count;
+} BenchLexer;
+
+static void bench_lexer__decode(BenchLexer *self) {
+    if (self->position >= self->length) {
+        self->base.lookahead = 0;
+        self->lookahead_size = 0;
+        return;
+    }
+
+    const uint8_t *p = self->input + self->position;
+    uint32_t remaining = self->length - self->position;
+    uint8_t c = p[0];
+    int32_t code_point = c;
+    uint32_t size = 1;
+
+    if (c >= 0xF0 && remaining >= 4) {
+        code_point = ((c & 0x07) << 18) | ((p[1] & 0x3F) << 12) | ((p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+        size = 4;
+    } else if (c >= 0xE0 && remaining >= 3) {
+        code_point = ((c & 0x0F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+        size = 3;
+    } else if (c >= 0xC0 && remaining >= 2) {
+        code_point = ((c & 0x1F) << 6) | (p[1] & 0x3F);
+        size = 2;
+    }
+
+    self->base.lookahead = code_point;
+    self->lookahead_size = size;
+}
+
+static void bench_lexer__advance(TSLexer *lexer, bool skip) {
+    BenchLexer *self = (BenchLexer *)lexer;
+    self->advance_count++;
+    if (self->position >= self->length) {
+        return;
+    }
+    self->position += self->lookahead_size;
+    if (skip) {
+        self->token_start = self->position;
+    }
+    bench_lexer__decode(self);
+}
+
+static void bench_lexer__mark_end(TSLexer *lexer) {
+    BenchLexer *self = (BenchLexer *)lexer;
+    self->mark_end_count++;
+    self->token_end = self->position;
+    self->did_mark_end = true;
+}
+
+static uint32_t bench_lexer__get_column(TSLexer *lexer) {
+    BenchLexer *self = (BenchLexer *)lexer;
+    uint32_t column = 0;
+    for (uint32_t i = self->position; i > 0 && self->input[i - 1] != '\n'; i--) {
+        // Count code points, not continuation bytes
+        if ((self->input[i - 1] & 0xC0) != 0x80) {
+            column++;
+        }
+    }
+    return column;
+}
+
+static bool bench_lexer__is_at_included_range_start(const TSLexer *lexer) {
+    (void)lexer;
+    return false;
+}
+
+static bool bench_lexer__eof(const TSLexer *lexer) {
+    const BenchLexer *self = (const BenchLexer *)lexer;
+    return self->position >= self->length;
+}
+
+static void bench_lexer__log(const TSLexer *lexer, const char *format, ...) {
+    (void)lexer;
+    (void)format;
+}
+
+static inline void bench_lexer_init(BenchLexer *self, const char *input, uint32_t length) {
+    memset(self, 0, sizeof(*self));
+    self->base.advance = bench_lexer__advance;
+    self->base.mark_end = bench_lexer__mark_end;
+    self->base.get_column = bench_lexer__get_column;
+    self->base.is_at_included_range_start = bench_lexer__is_at_included_range_start;
+    self->base.eof = bench_lexer__eof;
+    self->base.log = bench_lexer__log;
+    self->input = (const uint8_t *)input;
+    self->length = length;
+    bench_lexer__decode(self);
+}
+
+// Move to an absolute byte offset and start a new token there
+static inline void bench_lexer_reset(BenchLexer *self, uint32_t position) {
+    self->position = position < self->length ? position : self->length;
+    self->token_start = self->position;
+    self->token_end = self->position;
+    self->did_mark_end = false;
+    bench_lexer__decode(self);
+}
+
+// End of the token produced by the last successful scan. As in tree-sitter,
+// a scan that never called mark_end ends at the current position.
+static inline uint32_t bench_lexer_token_end(const BenchLexer *self) {
+    return self->did_mark_end ? self->token_end : self->position;
+}
+
+#endif // TREE_SITTER_RAZOR_BENCH_LEXER_H_
@@ -0,0 +1,183 @@
+/**
+ * Profile-guided optimization training run
+ *
+ * Drives an instrumented build of the language library (see the PGO notes in
+ * the Makefile and CMakeLists.txt) through the workloads it is tuned for:
+ * full parses of the generated corpus (see corpus.h), in the same mix of
+ * categories as the parse benchmark, and an incremental reparse of each file
+ * after a one-line edit in its middle, which is what an editor does on every
+ * keystroke. Files given on the command line are parsed the same way, in
+ * addition to the corpus.
+ *
+ * Nothing is timed; the counters the instrumented code writes on exit are
+ * the output.
+ *
+ * Usage: pgo_train [-n iterations] [file...]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "corpus.h"
+
+#include <tree_sitter/api.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+const TSLanguage *tree_sitter_razor(void);
+
+typedef struct {
+    BenchBuffer *contents;
+    uint32_t size;
+    uint32_t capacity;
+} TrainingSet;
+
+static void training_add(TrainingSet *set, BenchBuffer source) {
+    if (set->size == set->capacity) {
+        set->capacity = set->capacity ? set->capacity * 2 : 16;
+        set->contents = realloc(set->contents, set->capacity * sizeof(BenchBuffer));
+    }
+    set->contents[set->size++] = source;
+}
+
+static void training_generate(TrainingSet *set) {
+    for (unsigned i = 0; i < 40; i++) {
+        BenchBuffer source = {0};
+        generate_component(&source, i);
+        training_add(set, source);
+    }
+    for (unsigned i = 0; i < 40; i++) {
+        BenchBuffer source = {0};
+        generate_imports(&source, i, 400);
+        training_add(set, source);
+    }
+    for (unsigned i = 0; i < 4; i++) {
+        BenchBuffer source = {0};
+        generate_layout(&source, i, 5000);
+        training_add(set, source);
+    }
+    for (unsigned i = 0; i < 10; i++) {
+        BenchBuffer source = {0};
+        generate_foreach_table(&source, i, 200);
+        training_add(set, source);
+    }
+    for (unsigned i = 0; i < 10; i++) {
+        BenchBuffer source = {0};
+        generate_grid(&source, i, 200);
+        training_add(set, source);
+    }
+    for (unsigned i = 0; i < 10; i++) {
+        BenchBuffer source = {0};
+        generate_broken_layout(&source, i, 200);
+        training_add(set, source);
+    }
+    for (unsigned i = 0; i < 4; i++) {
+        BenchBuffer source = {0};
+        generate_script_page(&source, i, 256 << 10);
+        training_add(set, source);
+    }
+}
+
+static bool training_read(TrainingSet *set, const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        perror(path);
+        return false;
+    }
+    BenchBuffer source = {0};
+    char chunk[1 << 16];
+    size_t length;
+    while ((length = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        buffer_reserve(&source, (uint32_t)length);
+        memcpy(source.contents + source.size, chunk, length);
+        source.size += (uint32_t)length;
+    }
+    fclose(file);
+    training_add(set, source);
+    return true;
+}
+
+static TSPoint point_at(const BenchBuffer *source, uint32_t offset) {
+    TSPoint point = {0, 0};
+    for (uint32_t i = 0; i < offset; i++) {
+        if (source->contents[i] == '\n') {
+            point.row++;
+            point.column = 0;
+        } else {
+            point.column++;
+        }
+    }
+    return point;
+}
+
+// Parse `source`, then insert a line of markup with an expression in it at
+// the line break nearest its middle and reparse against the first tree
+static void train(TSParser *parser, const BenchBuffer *source) {
+    static const char LINE[] = "<p>@Model.Name</p>\n";
+    const uint32_t length = sizeof(LINE) - 1;
+
+    TSTree *tree = ts_parser_parse_string(parser, NULL, source->contents, source->size);
+
+    const char *newline = memchr(source->contents + source->size / 2, '\n', source->size - source->size / 2);
+    if (newline) {
+        uint32_t offset = (uint32_t)(newline - source->contents) + 1;
+        BenchBuffer edited = {0};
+        buffer_reserve(&edited, source->size + length);
+        memcpy(edited.contents, source->contents, offset);
+        memcpy(edited.contents + offset, LINE, length);
+        memcpy(edited.contents + offset + length, source->contents + offset, source->size - offset + 1);
+        edited.size = source->size + length;
+
+        TSPoint start = point_at(source, offset);
+        TSInputEdit edit = {
+            .start_byte = offset,
+            .old_end_byte = offset,
+            .new_end_byte = offset + length,
+            .start_point = start,
+            .old_end_point = start,
+            .new_end_point = {start.row + 1, 0},
+        };
+        ts_tree_edit(tree, &edit);
+        ts_tree_delete(ts_parser_parse_string(parser, tree, edited.contents, edited.size));
+        buffer_delete(&edited);
+    }
+
+    ts_tree_delete(tree);
+}
+
+int main(int argc, char **argv) {
+    unsigned iterations = 3;
+    TrainingSet set = {0};
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            iterations = (unsigned)strtoul(argv[++i], NULL, 10);
+            if (iterations == 0) {
+                iterations = 1;
+            }
+        } else if (!training_read(&set, argv[i])) {
+            return EXIT_FAILURE;
+        }
+    }
+    training_generate(&set);
+
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_razor());
+
+    uint64_t bytes = 0;
+    for (unsigned j = 0; j < iterations; j++) {
+        for (uint32_t i = 0; i < set.size; i++) {
+            train(parser, &set.contents[i]);
+            bytes += set.contents[i].size;
+        }
+    }
+    printf("trained on %u files, %.1f MB parsed\n", set.size, (double)bytes / (1024.0 * 1024.0));
+
+    ts_parser_delete(parser);
+    for (uint32_t i = 0; i < set.size; i++) {
+        buffer_delete(&set.contents[i]);
+    }
+    free(set.contents);
+    return EXIT_SUCCESS;
+}
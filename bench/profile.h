@@ -0,0 +1,33 @@
+/**
+ * External scanner profiling hooks for the parse benchmark
+ *
+ * scanner_profile.c compiles the scanner with its scan entry point wrapped,
+ * so that while profiling is enabled every call the parser makes is timed and
+ * charged to the token it returned (or to a "no token" bucket when it
+ * rejected). Kept in its own translation unit because the scanner's
+ * tree_sitter/parser.h cannot be included alongside tree_sitter/api.h.
+ */
+
+#ifndef TREE_SITTER_RAZOR_BENCH_PROFILE_H_
+#define TREE_SITTER_RAZOR_BENCH_PROFILE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+    uint64_t calls;
+    uint64_t nanoseconds;
+} TokenProfile;
+
+extern bool razor_profile_enabled;
+
+// Number of profile buckets: one per external token plus "no token"
+unsigned razor_profile_bucket_count(void);
+
+const char *razor_profile_bucket_name(unsigned bucket);
+
+const TokenProfile *razor_profile_bucket(unsigned bucket);
+
+void razor_profile_reset(void);
+
+#endif // TREE_SITTER_RAZOR_BENCH_PROFILE_H_
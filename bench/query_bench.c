@@ -0,0 +1,247 @@
+/**
+ * Query execution benchmark
+ *
+ * Parses a generated corpus (see corpus.h), or the files given on the command
+ * line, once, then runs each of the bundled queries over every tree with
+ * ts_query_cursor the way an editor would: captures in document order for
+ * highlights and locals, whole matches for tags and injections. Reports, per
+ * query:
+ *
+ *   - pattern count and compile time
+ *   - execution time per MB of source and p99 per-file latency
+ *   - captures per KB, and files whose match limit was exceeded
+ *
+ * Usage: query_bench [-n iterations] [-q query_dir] [file...]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "corpus.h"
+
+#include <tree_sitter/api.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+const TSLanguage *tree_sitter_razor(void);
+
+typedef struct {
+    const char *name;
+    bool by_capture;
+} QuerySpec;
+
+static const QuerySpec QUERIES[] = {
+    {"highlights", true},
+    {"locals", true},
+    {"tags", false},
+    {"injections", false},
+};
+
+typedef struct {
+    const char *name;
+    BenchBuffer source;
+    TSTree *tree;
+} BenchFile;
+
+typedef struct {
+    BenchFile *contents;
+    uint32_t size;
+    uint32_t capacity;
+} BenchCorpus;
+
+static void corpus_add(BenchCorpus *corpus, const char *name, BenchBuffer source) {
+    if (corpus->size == corpus->capacity) {
+        corpus->capacity = corpus->capacity ? corpus->capacity * 2 : 16;
+        corpus->contents = realloc(corpus->contents, corpus->capacity * sizeof(BenchFile));
+    }
+    corpus->contents[corpus->size++] = (BenchFile){name, source, NULL};
+}
+
+static void corpus_generate(BenchCorpus *corpus) {
+    for (unsigned i = 0; i < 40; i++) {
+        BenchBuffer source = {0};
+        generate_component(&source, i);
+        corpus_add(corpus, "Edit.razor", source);
+    }
+    for (unsigned i = 0; i < 4; i++) {
+        BenchBuffer source = {0};
+        generate_layout(&source, i, 5000);
+        corpus_add(corpus, "_Layout.cshtml", source);
+    }
+    for (unsigned i = 0; i < 10; i++) {
+        BenchBuffer source = {0};
+        generate_foreach_table(&source, i, 200);
+        corpus_add(corpus, "Orders.cshtml", source);
+    }
+    for (unsigned i = 0; i < 4; i++) {
+        BenchBuffer source = {0};
+        generate_script_page(&source, i, 256 << 10);
+        corpus_add(corpus, "Bundle.cshtml", source);
+    }
+}
+
+static bool read_file(const char *path, BenchBuffer *buffer) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    char chunk[1 << 16];
+    size_t length;
+    while ((length = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        buffer_reserve(buffer, (uint32_t)length);
+        memcpy(buffer->contents + buffer->size, chunk, length);
+        buffer->size += (uint32_t)length;
+    }
+    fclose(file);
+    return true;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static const char *query_error_name(TSQueryError error) {
+    switch (error) {
+        case TSQueryErrorSyntax: return "syntax";
+        case TSQueryErrorNodeType: return "node type";
+        case TSQueryErrorField: return "field";
+        case TSQueryErrorCapture: return "capture";
+        case TSQueryErrorStructure: return "structure";
+        case TSQueryErrorLanguage: return "language";
+        default: return "unknown";
+    }
+}
+
+// Run `query` over `tree` to completion and return the number of captures
+static uint64_t run_query(TSQueryCursor *cursor, const TSQuery *query, const TSTree *tree, bool by_capture) {
+    uint64_t captures = 0;
+    TSQueryMatch match;
+    ts_query_cursor_exec(cursor, query, ts_tree_root_node(tree));
+    if (by_capture) {
+        uint32_t capture_index;
+        while (ts_query_cursor_next_capture(cursor, &match, &capture_index)) {
+            captures++;
+        }
+    } else {
+        while (ts_query_cursor_next_match(cursor, &match)) {
+            captures += match.capture_count;
+        }
+    }
+    return captures;
+}
+
+int main(int argc, char **argv) {
+    unsigned iterations = 5;
+    const char *query_dir = "queries";
+    BenchCorpus corpus = {0};
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            iterations = (unsigned)strtoul(argv[++i], NULL, 10);
+            if (iterations == 0) {
+                iterations = 1;
+            }
+        } else if (strcmp(argv[i], "-q") == 0 && i + 1 < argc) {
+            query_dir = argv[++i];
+        } else {
+            BenchBuffer source = {0};
+            if (!read_file(argv[i], &source)) {
+                perror(argv[i]);
+                return EXIT_FAILURE;
+            }
+            corpus_add(&corpus, argv[i], source);
+        }
+    }
+    if (corpus.size == 0) {
+        corpus_generate(&corpus);
+    }
+
+    const TSLanguage *language = tree_sitter_razor();
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, language);
+
+    uint64_t total_bytes = 0;
+    for (uint32_t i = 0; i < corpus.size; i++) {
+        BenchFile *file = &corpus.contents[i];
+        file->tree = ts_parser_parse_string(parser, NULL, file->source.contents, file->source.size);
+        total_bytes += file->source.size;
+    }
+
+    printf("%u files, %.1f KB\n\n", corpus.size, (double)total_bytes / 1024.0);
+    printf("%-12s %8s %10s %9s %9s %9s %10s %7s\n", "query", "patterns", "compile ms", "ms/MB", "MB/s",
+           "p99 ms", "caps/KB", "limit");
+
+    TSQueryCursor *cursor = ts_query_cursor_new();
+    double *samples = malloc(sizeof(double) * corpus.size * iterations + 1);
+    int status = EXIT_SUCCESS;
+
+    for (unsigned q = 0; q < sizeof(QUERIES) / sizeof(QUERIES[0]); q++) {
+        char path[4096];
+        snprintf(path, sizeof(path), "%s/%s.scm", query_dir, QUERIES[q].name);
+        BenchBuffer source = {0};
+        if (!read_file(path, &source)) {
+            printf("%-12s (missing)\n", QUERIES[q].name);
+            continue;
+        }
+
+        uint32_t error_offset;
+        TSQueryError error_type;
+        double start = now_seconds();
+        TSQuery *query = ts_query_new(language, source.contents, source.size, &error_offset, &error_type);
+        double compile = now_seconds() - start;
+        if (!query) {
+            fprintf(stderr, "%s: %s error at byte %u\n", path, query_error_name(error_type), error_offset);
+            buffer_delete(&source);
+            status = EXIT_FAILURE;
+            continue;
+        }
+
+        uint64_t captures = 0;
+        uint32_t limit_exceeded = 0;
+        uint32_t sample_count = 0;
+        double total = 0;
+        for (unsigned j = 0; j < iterations; j++) {
+            for (uint32_t i = 0; i < corpus.size; i++) {
+                const BenchFile *file = &corpus.contents[i];
+                start = now_seconds();
+                uint64_t count = run_query(cursor, query, file->tree, QUERIES[q].by_capture);
+                double elapsed = now_seconds() - start;
+                samples[sample_count++] = elapsed;
+                total += elapsed;
+                if (j == 0) {
+                    captures += count;
+                    limit_exceeded += ts_query_cursor_did_exceed_match_limit(cursor);
+                }
+            }
+        }
+
+        qsort(samples, sample_count, sizeof(double), compare_doubles);
+        double megabytes = (double)total_bytes * iterations / 1e6;
+        printf("%-12s %8u %10.3f %9.2f %9.2f %9.3f %10.1f %7u\n", QUERIES[q].name,
+               ts_query_pattern_count(query), compile * 1e3, total * 1e3 / megabytes, megabytes / total,
+               samples[(uint32_t)(0.99 * (double)(sample_count - 1) + 0.5)] * 1e3,
+               (double)captures * 1024.0 / (double)total_bytes, limit_exceeded);
+
+        ts_query_delete(query);
+        buffer_delete(&source);
+    }
+
+    free(samples);
+    ts_query_cursor_delete(cursor);
+    for (uint32_t i = 0; i < corpus.size; i++) {
+        ts_tree_delete(corpus.contents[i].tree);
+        buffer_delete(&corpus.contents[i].source);
+    }
+    free(corpus.contents);
+    ts_parser_delete(parser);
+    return status;
+}
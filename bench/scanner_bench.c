@@ -0,0 +1,265 @@
+/**
+ * External scanner microbenchmarks
+ *
+ * Drives tree_sitter_razor_external_scanner_scan directly through the
+ * in-memory lexer in lexer.h, so the scanner's hot paths can be timed in
+ * isolation from the parse tables. Each case scans a generated input with the
+ * valid_symbols set the parser would pass in that position and reports
+ * throughput together with the number of lexer callbacks per byte.
+ *
+ * The scanner is compiled into this file, so pointing the include path at a
+ * different src/ directory benchmarks that revision instead:
+ *
+ *   cc -O2 -std=c11 -I path/to/other/src bench/scanner_bench.c
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "scanner.c"
+
+#include "corpus.h"
+#include "lexer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Minimum wall time spent on each case
+#define BENCH_MIN_SECONDS 0.25
+
+// Minified-bundle-like JavaScript: comparisons, markup in strings and closing
+// tags of other elements all put '<' in front of the scanner.
+static void generate_script(BenchBuffer *buffer, uint32_t size) {
+    for (unsigned i = 0; buffer->size < size; i++) {
+        buffer_appendf(buffer,
+                       "function f%u(a,b){if(a<b&&b.length<%u){el.innerHTML=\"<div class='x'>\"+a+\"</div>\";}"
+                       "return a<=b?a:b;}\n",
+                       i, i % 97);
+    }
+}
+
+static void generate_style(BenchBuffer *buffer, uint32_t size) {
+    for (unsigned i = 0; buffer->size < size; i++) {
+        buffer_appendf(buffer, ".c%u > .item:not(.hidden) { margin: 0 %upx; color: #%06x; }\n",
+                       i, i % 16, (i * 2654435761u) & 0xFFFFFF);
+    }
+}
+
+static void generate_textarea(BenchBuffer *buffer, uint32_t size) {
+    while (buffer->size < size) {
+        buffer_append(buffer, "Dear customer, <b>thank you</b> for your order.\n"
+                              "Totals: 3 < 4 and 5 > 2, see </p> for details.\n");
+    }
+}
+
+// Indented prose as it appears between tags: no markup, no Razor transitions
+// and no punctuation that would end an HTML_TEXT_CONTENT token
+static void generate_prose(BenchBuffer *buffer, uint32_t size) {
+    while (buffer->size < size) {
+        buffer_append(buffer, "        Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod\n"
+                              "        tempor incididunt ut labore et dolore magna aliqua; ut enim ad minim\n"
+                              "        conveniam, quis nostrud exercitation ullamco laboris nisi ut aliquip\n");
+    }
+}
+
+// Deeply nested @if blocks laid out one brace per line, as in Blazor
+// components: every token is a run of indentation followed by the { that
+// opens a Razor block or the } that closes it.
+static void generate_indented_blocks(BenchBuffer *buffer, uint32_t size) {
+    const unsigned depth = 24;
+    while (buffer->size < size) {
+        for (unsigned level = 0; level < 2 * depth; level++) {
+            bool open = level < depth;
+            unsigned indent = 4 * (open ? level : 2 * depth - 1 - level);
+            buffer_appendf(buffer, "\n%*s%c", indent, "", open ? '{' : '}');
+        }
+    }
+}
+
+typedef struct {
+    const char *name;
+    void (*generate)(BenchBuffer *, uint32_t);
+    uint32_t size;
+    const char *end_tag;
+    enum RazorTokenType tokens[4];  // Valid symbols, terminated by 0
+} BenchCase;
+
+static const BenchCase CASES[] = {
+    {"script 4KB", generate_script, 4 << 10, "</script>", {SCRIPT_CONTENT, CSHARP_COMMENT, CSHARP_PREPROC}},
+    {"script 64KB", generate_script, 64 << 10, "</script>", {SCRIPT_CONTENT, CSHARP_COMMENT, CSHARP_PREPROC}},
+    {"script 512KB", generate_script, 512 << 10, "</script>", {SCRIPT_CONTENT, CSHARP_COMMENT, CSHARP_PREPROC}},
+    {"style 64KB", generate_style, 64 << 10, "</style>", {STYLE_CONTENT, CSHARP_COMMENT, CSHARP_PREPROC}},
+    {"textarea 64KB", generate_textarea, 64 << 10, "</textarea>", {TEXTAREA_CONTENT, CSHARP_COMMENT, CSHARP_PREPROC}},
+    {"text 64KB", generate_prose, 64 << 10, NULL, {HTML_TEXT_CONTENT, CSHARP_COMMENT, CSHARP_PREPROC}},
+    {"indented blocks 64KB", generate_indented_blocks, 64 << 10, NULL,
+     {RAZOR_BLOCK_OPEN, CSHARP_CONTEXT_CLOSE, CSHARP_COMMENT, CSHARP_PREPROC}},
+};
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int run_case(const BenchCase *bench_case) {
+    BenchBuffer buffer = {0};
+    bench_case->generate(&buffer, bench_case->size);
+    uint32_t content_size = buffer.size;
+    if (bench_case->end_tag) {
+        buffer_append(&buffer, bench_case->end_tag);
+    }
+
+    bool valid_symbols[EXTERNAL_TOKEN_COUNT] = {false};
+    for (unsigned i = 0; i < 4 && bench_case->tokens[i]; i++) {
+        valid_symbols[bench_case->tokens[i]] = true;
+    }
+
+    void *scanner = tree_sitter_razor_external_scanner_create();
+    BenchLexer lexer;
+    bench_lexer_init(&lexer, buffer.contents, buffer.size);
+
+    uint64_t iterations = 0;
+    uint64_t bytes = 0;
+    uint64_t tokens = 0;
+    double start = now_seconds();
+    double elapsed = 0;
+
+    do {
+        // Scan the whole input as a sequence of tokens, as the parser would
+        uint32_t position = 0;
+        while (position < content_size) {
+            bench_lexer_reset(&lexer, position);
+            if (!tree_sitter_razor_external_scanner_scan(scanner, &lexer.base, valid_symbols)) {
+                break;
+            }
+            uint32_t end = bench_lexer_token_end(&lexer);
+            if (end <= position) {
+                break;
+            }
+            position = end;
+            tokens++;
+        }
+        if (position != content_size) {
+            fprintf(stderr, "%s: scan stopped at byte %u, expected %u\n", bench_case->name, position,
+                    content_size);
+            buffer_delete(&buffer);
+            tree_sitter_razor_external_scanner_destroy(scanner);
+            return 1;
+        }
+        bytes += content_size;
+        iterations++;
+        elapsed = now_seconds() - start;
+    } while (elapsed < BENCH_MIN_SECONDS);
+
+    printf("%-24s %8.1f MB/s %8.2f ns/byte %6.2f advance/byte %8.4f mark_end/byte %6.1f tokens/iter\n",
+           bench_case->name, (double)bytes / elapsed / 1e6, elapsed * 1e9 / (double)bytes,
+           (double)lexer.advance_count / (double)bytes, (double)lexer.mark_end_count / (double)bytes,
+           (double)tokens / (double)iterations);
+
+    buffer_delete(&buffer);
+    tree_sitter_razor_external_scanner_destroy(scanner);
+    return 0;
+}
+
+// Rejection paths: the parser asks the scanner first at every token in
+// markup, and most of those calls find nothing because the token is a tag,
+// an attribute or plain text for the generated lexer. This case calls the
+// scanner at every byte of a layout page with the valid symbols of element
+// content, and reports the cost of a call and the characters it reads.
+static void run_markup_probe(void) {
+    BenchBuffer buffer = {0};
+    generate_layout(&buffer, 0, 400);
+
+    bool valid_symbols[EXTERNAL_TOKEN_COUNT] = {
+        [TEXT_WITH_LITERAL_AT] = true,
+        [CSHARP_CODE_BLOCK_START] = true,
+        [CSHARP_EXPLICIT_EXPR_START] = true,
+        [RAZOR_COMMENT] = true,
+        [HTML_COMMENT] = true,
+    };
+
+    void *scanner = tree_sitter_razor_external_scanner_create();
+    BenchLexer lexer;
+    bench_lexer_init(&lexer, buffer.contents, buffer.size);
+
+    uint64_t calls = 0;
+    uint64_t tokens = 0;
+    double start = now_seconds();
+    double elapsed = 0;
+    do {
+        for (uint32_t position = 0; position < buffer.size; position++) {
+            bench_lexer_reset(&lexer, position);
+            tokens += tree_sitter_razor_external_scanner_scan(scanner, &lexer.base, valid_symbols);
+            calls++;
+        }
+        elapsed = now_seconds() - start;
+    } while (elapsed < BENCH_MIN_SECONDS);
+
+    printf("%-24s %8.1f ns/call %6.2f advance/call %6.3f tokens/call\n", "markup probe",
+           elapsed * 1e9 / (double)calls, (double)lexer.advance_count / (double)calls,
+           (double)tokens / (double)calls);
+
+    buffer_delete(&buffer);
+    tree_sitter_razor_external_scanner_destroy(scanner);
+}
+
+// Parser lifecycle as seen by a service that creates a parser per request:
+// create, restore the state of a nested position, serialize it back, destroy
+static void run_lifecycle(void) {
+    void *scanner = tree_sitter_razor_external_scanner_create();
+    for (unsigned i = 0; i < 8; i++) {
+        BenchLexer lexer;
+        bench_lexer_init(&lexer, "@{", 2);
+        bool valid_symbols[EXTERNAL_TOKEN_COUNT] = {[CSHARP_CODE_BLOCK_START] = true};
+        tree_sitter_razor_external_scanner_scan(scanner, &lexer.base, valid_symbols);
+    }
+    char state[TREE_SITTER_SERIALIZATION_BUFFER_SIZE];
+    unsigned state_length = tree_sitter_razor_external_scanner_serialize(scanner, state);
+    tree_sitter_razor_external_scanner_destroy(scanner);
+
+    uint64_t iterations = 0;
+    double start = now_seconds();
+    double elapsed = 0;
+    do {
+        for (unsigned i = 0; i < 1024; i++) {
+            char buffer[TREE_SITTER_SERIALIZATION_BUFFER_SIZE];
+            scanner = tree_sitter_razor_external_scanner_create();
+            tree_sitter_razor_external_scanner_deserialize(scanner, state, state_length);
+            tree_sitter_razor_external_scanner_serialize(scanner, buffer);
+            tree_sitter_razor_external_scanner_destroy(scanner);
+        }
+        iterations += 1024;
+        elapsed = now_seconds() - start;
+    } while (elapsed < BENCH_MIN_SECONDS);
+
+    printf("%-24s %8.1f ns/cycle\n", "create/destroy", elapsed * 1e9 / (double)iterations);
+}
+
+int main(int argc, char **argv) {
+    int failures = 0;
+    for (unsigned i = 0; i < sizeof(CASES) / sizeof(CASES[0]); i++) {
+        // Optional arguments select cases by name prefix
+        bool selected = argc < 2;
+        for (int j = 1; j < argc && !selected; j++) {
+            selected = strncmp(CASES[i].name, argv[j], strlen(argv[j])) == 0;
+        }
+        if (selected) {
+            failures += run_case(&CASES[i]);
+        }
+    }
+    bool probe_selected = argc < 2;
+    for (int j = 1; j < argc && !probe_selected; j++) {
+        probe_selected = strncmp("markup probe", argv[j], strlen(argv[j])) == 0;
+    }
+    if (probe_selected) {
+        run_markup_probe();
+    }
+    bool lifecycle_selected = argc < 2;
+    for (int j = 1; j < argc && !lifecycle_selected; j++) {
+        lifecycle_selected = strncmp("create/destroy", argv[j], strlen(argv[j])) == 0;
+    }
+    if (lifecycle_selected) {
+        run_lifecycle();
+    }
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
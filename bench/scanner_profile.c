@@ -0,0 +1,55 @@
+/**
+ * Timed wrapper around the external scanner (see profile.h)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#define TREE_SITTER_RAZOR_TOKEN_NAMES
+#define tree_sitter_razor_external_scanner_scan razor_profile_inner_scan
+#include "scanner.c"
+#undef tree_sitter_razor_external_scanner_scan
+
+#include "profile.h"
+
+#include <time.h>
+
+static TokenProfile profiles[EXTERNAL_TOKEN_COUNT + 1];
+
+bool razor_profile_enabled = false;
+
+static inline uint64_t now_nanoseconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+bool tree_sitter_razor_external_scanner_scan(void *payload, TSLexer *lexer, const bool *valid_symbols) {
+    if (!razor_profile_enabled) {
+        return razor_profile_inner_scan(payload, lexer, valid_symbols);
+    }
+
+    uint64_t start = now_nanoseconds();
+    bool result = razor_profile_inner_scan(payload, lexer, valid_symbols);
+    uint64_t elapsed = now_nanoseconds() - start;
+
+    unsigned bucket = result && lexer->result_symbol < EXTERNAL_TOKEN_COUNT ? lexer->result_symbol
+                                                                             : EXTERNAL_TOKEN_COUNT;
+    profiles[bucket].calls++;
+    profiles[bucket].nanoseconds += elapsed;
+    return result;
+}
+
+unsigned razor_profile_bucket_count(void) { return EXTERNAL_TOKEN_COUNT + 1; }
+
+const char *razor_profile_bucket_name(unsigned bucket) {
+    if (bucket == EXTERNAL_TOKEN_COUNT) {
+        return "(no token)";
+    }
+    return bucket < EXTERNAL_TOKEN_COUNT ? EXTERNAL_TOKEN_NAMES[bucket] : NULL;
+}
+
+const TokenProfile *razor_profile_bucket(unsigned bucket) {
+    return bucket <= EXTERNAL_TOKEN_COUNT ? &profiles[bucket] : NULL;
+}
+
+void razor_profile_reset(void) { memset(profiles, 0, sizeof(profiles)); }
@@ -0,0 +1,442 @@
+/**
+ * External scanner tests
+ *
+ * Drives the scanner through the in-memory lexer in lexer.h, as
+ * scanner_bench.c does, for what the corpus tests cannot show:
+ *
+ * - the context stack at its limits: nesting of one kind far deeper than the
+ *   run array, nesting that alternates between braces and parentheses past
+ *   CONTEXT_RUN_CAPACITY, and the serialized state of both surviving a round
+ *   trip, next to a C# state of any size
+ * - which token each construct after an @, and a '.' after an implicit
+ *   expression, produces, and where it ends
+ * - contexts left open by error recovery being dropped
+ *
+ * Exits non-zero on the first failed check.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "scanner.c"
+
+#include "lexer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK(condition)                                                      \
+    do {                                                                      \
+        if (!(condition)) {                                                   \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            exit(EXIT_FAILURE);                                               \
+        }                                                                     \
+    } while (0)
+
+typedef struct {
+    unsigned token;  // EXTERNAL_TOKEN_COUNT if none was produced
+    uint32_t start;
+    uint32_t end;
+} ScanResult;
+
+// Scan `input` from byte `offset` with the given tokens valid
+static ScanResult scan_at(RazorScanner *scanner, const char *input, uint32_t offset, const bool *valid_symbols) {
+    BenchLexer lexer;
+    bench_lexer_init(&lexer, input, (uint32_t)strlen(input));
+    bench_lexer_reset(&lexer, offset);
+    if (!tree_sitter_razor_external_scanner_scan(scanner, &lexer.base, valid_symbols)) {
+        return (ScanResult){EXTERNAL_TOKEN_COUNT, 0, 0};
+    }
+    return (ScanResult){lexer.base.result_symbol, lexer.token_start, bench_lexer_token_end(&lexer)};
+}
+
+// Scan `input` with only `token` valid. Returns whether that token was
+// produced over the whole input.
+static bool scan_token(RazorScanner *scanner, const char *input, enum RazorTokenType token) {
+    bool valid_symbols[EXTERNAL_TOKEN_COUNT] = {0};
+    valid_symbols[token] = true;
+
+    ScanResult result = scan_at(scanner, input, 0, valid_symbols);
+    return result.token == token && result.end == strlen(input);
+}
+
+static bool open_context(RazorScanner *scanner, ContextType type) {
+    return type == CONTEXT_CSHARP_PAREN ? scan_token(scanner, "@(", CSHARP_EXPLICIT_EXPR_START)
+                                        : scan_token(scanner, "@{", CSHARP_CODE_BLOCK_START);
+}
+
+static bool close_context(RazorScanner *scanner, ContextType type) {
+    return scan_token(scanner, type == CONTEXT_CSHARP_PAREN ? ")" : "}", CSHARP_CONTEXT_CLOSE);
+}
+
+typedef struct {
+    char contents[TREE_SITTER_SERIALIZATION_BUFFER_SIZE];
+    unsigned length;
+} SerializedState;
+
+static SerializedState serialize(RazorScanner *scanner) {
+    SerializedState state;
+    state.length = tree_sitter_razor_external_scanner_serialize(scanner, state.contents);
+    return state;
+}
+
+static bool same_state(const SerializedState *a, const SerializedState *b) {
+    return a->length == b->length && memcmp(a->contents, b->contents, a->length) == 0;
+}
+
+// Serialize, deserialize into a new scanner and check that it serializes the
+// same way
+static RazorScanner *round_trip(RazorScanner *scanner) {
+    SerializedState state = serialize(scanner);
+    RazorScanner *copy = tree_sitter_razor_external_scanner_create();
+    tree_sitter_razor_external_scanner_deserialize(copy, state.contents, state.length);
+    SerializedState copied = serialize(copy);
+    CHECK(same_state(&state, &copied));
+    tree_sitter_razor_external_scanner_destroy(scanner);
+    return copy;
+}
+
+// 300 code blocks inside each other are one run
+static void test_deep_nesting(void) {
+    RazorScanner *scanner = tree_sitter_razor_external_scanner_create();
+    SerializedState empty = serialize(scanner);
+
+    for (unsigned i = 0; i < 300; i++) {
+        CHECK(open_context(scanner, CONTEXT_CSHARP_BRACE));
+    }
+    CHECK(scanner->context_run_count == 1);
+    CHECK(serialize(scanner).length == empty.length + 2);
+
+    scanner = round_trip(scanner);
+    for (unsigned i = 0; i < 300; i++) {
+        CHECK(!close_context(scanner, CONTEXT_CSHARP_PAREN));
+        CHECK(close_context(scanner, CONTEXT_CSHARP_BRACE));
+    }
+    CHECK(!in_csharp_context(scanner));
+    SerializedState closed = serialize(scanner);
+    CHECK(same_state(&closed, &empty));
+
+    tree_sitter_razor_external_scanner_destroy(scanner);
+}
+
+// Alternating contexts fill one run each. Once they are all in use, a new
+// run is refused without touching the others, and every context that was
+// opened closes in order afterwards.
+static void test_alternating_nesting(void) {
+    ContextType opened[CONTEXT_RUN_CAPACITY + 16];
+    unsigned open_count = 0;
+    RazorScanner *scanner = tree_sitter_razor_external_scanner_create();
+
+    for (unsigned i = 0; i < CONTEXT_RUN_CAPACITY; i++) {
+        ContextType type = i % 2 ? CONTEXT_CSHARP_PAREN : CONTEXT_CSHARP_BRACE;
+        CHECK(open_context(scanner, type));
+        opened[open_count++] = type;
+    }
+    CHECK(scanner->context_run_count == CONTEXT_RUN_CAPACITY);
+
+    // Past the capacity, a context of the other kind than the innermost one
+    // is refused, while the innermost run still takes contexts of its own
+    for (unsigned i = 0; i < 16; i++) {
+        ContextType top = context_top(scanner);
+        ContextType other = top == CONTEXT_CSHARP_PAREN ? CONTEXT_CSHARP_BRACE : CONTEXT_CSHARP_PAREN;
+        SerializedState before = serialize(scanner);
+        CHECK(!open_context(scanner, other));
+        SerializedState after = serialize(scanner);
+        CHECK(same_state(&before, &after));
+
+        CHECK(open_context(scanner, top));
+        opened[open_count++] = top;
+    }
+    CHECK(scanner->context_run_count == CONTEXT_RUN_CAPACITY);
+
+    scanner = round_trip(scanner);
+    while (open_count > 0) {
+        ContextType type = opened[--open_count];
+        ContextType other = type == CONTEXT_CSHARP_PAREN ? CONTEXT_CSHARP_BRACE : CONTEXT_CSHARP_PAREN;
+        CHECK(context_top(scanner) == type);
+        CHECK(!close_context(scanner, other));
+        CHECK(close_context(scanner, type));
+        if (open_count % 8 == 0) {
+            scanner = round_trip(scanner);
+        }
+    }
+    CHECK(!in_csharp_context(scanner));
+
+    tree_sitter_razor_external_scanner_destroy(scanner);
+}
+
+// States that no scanner writes: a run count past the capacity, runs cut
+// short, an empty run
+static void test_malformed_state(void) {
+    RazorScanner *scanner = tree_sitter_razor_external_scanner_create();
+    CHECK(open_context(scanner, CONTEXT_CSHARP_BRACE));
+    SerializedState state = serialize(scanner);
+
+    SerializedState bad = state;
+    bad.contents[0] = (char)(CONTEXT_RUN_CAPACITY + 1);
+    tree_sitter_razor_external_scanner_deserialize(scanner, bad.contents, bad.length);
+    CHECK(!in_csharp_context(scanner));
+
+    bad = state;
+    bad.length = 2;
+    tree_sitter_razor_external_scanner_deserialize(scanner, bad.contents, bad.length);
+    CHECK(!in_csharp_context(scanner));
+
+    bad = state;
+    bad.contents[1] = 0;
+    bad.contents[2] = 0;
+    tree_sitter_razor_external_scanner_deserialize(scanner, bad.contents, bad.length);
+    CHECK(!in_csharp_context(scanner));
+
+    tree_sitter_razor_external_scanner_deserialize(scanner, state.contents, state.length);
+    CHECK(in_csharp_context(scanner) && context_top(scanner) == CONTEXT_CSHARP_BRACE);
+
+    tree_sitter_razor_external_scanner_destroy(scanner);
+}
+
+// Every run is kept next to a C# state too large to fit behind them, as
+// interpolated strings nested hundreds deep give the C# scanner
+static void test_large_csharp_state(void) {
+    RazorScanner *scanner = tree_sitter_razor_external_scanner_create();
+    for (unsigned i = 0; i < CONTEXT_RUN_CAPACITY; i++) {
+        CHECK(open_context(scanner, i % 2 ? CONTEXT_CSHARP_PAREN : CONTEXT_CSHARP_BRACE));
+    }
+    array_grow_by(&scanner->csharp.interpolation_stack, 250);
+
+    SerializedState state = serialize(scanner);
+    CHECK(state.length >= 2 * CONTEXT_RUN_CAPACITY + 1);
+    CHECK(state.length <= TREE_SITTER_SERIALIZATION_BUFFER_SIZE);
+    RazorScanner *copy = tree_sitter_razor_external_scanner_create();
+    tree_sitter_razor_external_scanner_deserialize(copy, state.contents, state.length);
+    CHECK(copy->context_run_count == CONTEXT_RUN_CAPACITY);
+    CHECK(memcmp(copy->context_runs, scanner->context_runs, sizeof(scanner->context_runs)) == 0);
+
+    tree_sitter_razor_external_scanner_destroy(copy);
+    tree_sitter_razor_external_scanner_destroy(scanner);
+}
+
+// In markup, @ and a directive name are one token, and in front of a
+// statement keyword only the @ is; any other identifier is left to the
+// grammar. Valid symbols are those of a line start between top-level nodes.
+static void test_at_keywords(void) {
+    static const struct {
+        const char *input;
+        unsigned token;  // EXTERNAL_TOKEN_COUNT for none
+        uint32_t end;
+    } CASES[] = {
+        {"@page \"/counter\"", PAGE_DIRECTIVE_KEYWORD, 5},
+        {"@model IndexModel", MODEL_DIRECTIVE_KEYWORD, 6},
+        {"@inject IFoo Foo", INJECT_DIRECTIVE_KEYWORD, 7},
+        {"@inherits Base", INHERITS_DIRECTIVE_KEYWORD, 9},
+        {"@namespace App", NAMESPACE_DIRECTIVE_KEYWORD, 10},
+        {"@functions {", FUNCTIONS_DIRECTIVE_KEYWORD, 10},
+        {"@code {", CODE_DIRECTIVE_KEYWORD, 5},
+        {"@section Scripts {", SECTION_DIRECTIVE_KEYWORD, 8},
+        {"@layout MainLayout", LAYOUT_DIRECTIVE_KEYWORD, 7},
+        {"@attribute [Authorize]", ATTRIBUTE_DIRECTIVE_KEYWORD, 10},
+        {"@implements IDisposable", IMPLEMENTS_DIRECTIVE_KEYWORD, 11},
+        {"@typeparam TItem", TYPEPARAM_DIRECTIVE_KEYWORD, 10},
+        {"@preservewhitespace true", PRESERVEWHITESPACE_DIRECTIVE_KEYWORD, 19},
+        {"@rendermode InteractiveServer", RENDERMODE_DIRECTIVE_KEYWORD, 11},
+        {"@addTagHelper *, App", ADDTAGHELPER_DIRECTIVE_KEYWORD, 13},
+        {"@removeTagHelper *, App", REMOVETAGHELPER_DIRECTIVE_KEYWORD, 16},
+        {"@tagHelperPrefix th:", TAGHELPERPREFIX_DIRECTIVE_KEYWORD, 16},
+        {"@if (x)", RAZOR_STATEMENT_START, 1},
+        {"@foreach(var x in y)", RAZOR_STATEMENT_START, 1},
+        {"@using (var x = y)", RAZOR_STATEMENT_START, 1},
+        {"@await using (x)", RAZOR_STATEMENT_START, 1},
+        {"@pages", EXTERNAL_TOKEN_COUNT, 0},
+        {"@Page", EXTERNAL_TOKEN_COUNT, 0},
+        {"@ifx", EXTERNAL_TOKEN_COUNT, 0},
+        {"@using System", EXTERNAL_TOKEN_COUNT, 0},
+        {"@await Task.Delay(1)", EXTERNAL_TOKEN_COUNT, 0},
+        {"@Model.Name", EXTERNAL_TOKEN_COUNT, 0},
+    };
+
+    bool valid_symbols[EXTERNAL_TOKEN_COUNT] = {0};
+    valid_symbols[HTML_TEXT_CONTENT] = true;
+    for (unsigned token = RAZOR_STATEMENT_START; token < EXTERNAL_TOKEN_COUNT; token++) {
+        valid_symbols[token] = true;
+    }
+
+    RazorScanner *scanner = tree_sitter_razor_external_scanner_create();
+    for (unsigned i = 0; i < sizeof(CASES) / sizeof(CASES[0]); i++) {
+        ScanResult result = scan_at(scanner, CASES[i].input, 0, valid_symbols);
+        if (result.token != CASES[i].token || (result.token != EXTERNAL_TOKEN_COUNT && result.end != CASES[i].end)) {
+            fprintf(stderr, "%s: got token %u ending at %u\n", CASES[i].input, result.token, result.end);
+        }
+        CHECK(result.token == CASES[i].token);
+        CHECK(result.token == EXTERNAL_TOKEN_COUNT || result.end == CASES[i].end);
+    }
+
+    // A directive keyword is only produced where razor_directive is valid
+    bool statements_only[EXTERNAL_TOKEN_COUNT] = {0};
+    statements_only[RAZOR_STATEMENT_START] = true;
+    CHECK(scan_at(scanner, "@code {", 0, statements_only).token == EXTERNAL_TOKEN_COUNT);
+    CHECK(scan_at(scanner, "@if (x)", 0, statements_only).token == RAZOR_STATEMENT_START);
+
+    tree_sitter_razor_external_scanner_destroy(scanner);
+}
+
+// After an implicit expression in markup, a '.' right in front of a member
+// name continues it; any other '.' is text. Valid symbols are those after
+// @Model in element content.
+static void test_member_dot(void) {
+    static const struct {
+        const char *input;
+        uint32_t offset;
+        bool member_dot;
+    } CASES[] = {
+        {".Name", 0, true},
+        {"._field", 0, true},
+        {".\xc3\xa9t\xc3\xa9", 0, true},  // .été
+        {". Name", 0, false},
+        {".5 items", 0, false},
+        {"..Name", 0, false},
+        {"x .Name", 1, false},  // After whitespace
+        {"x.", 1, false},       // At the end of the input
+    };
+
+    bool valid_symbols[EXTERNAL_TOKEN_COUNT] = {0};
+    valid_symbols[RAZOR_MEMBER_DOT] = true;
+    valid_symbols[TEXT_WITH_LITERAL_AT] = true;
+    valid_symbols[HTML_TEXT_CONTENT] = true;
+
+    RazorScanner *scanner = tree_sitter_razor_external_scanner_create();
+    for (unsigned i = 0; i < sizeof(CASES) / sizeof(CASES[0]); i++) {
+        ScanResult result = scan_at(scanner, CASES[i].input, CASES[i].offset, valid_symbols);
+        if (CASES[i].member_dot) {
+            CHECK(result.token == RAZOR_MEMBER_DOT);
+            CHECK(result.end == CASES[i].offset + 1);
+        } else {
+            CHECK(result.token != RAZOR_MEMBER_DOT);
+        }
+    }
+
+    // In error recovery, where raw text is valid too, '.' is left to the
+    // other tokens
+    valid_symbols[SCRIPT_CONTENT] = true;
+    valid_symbols[STYLE_CONTENT] = true;
+    CHECK(scan_at(scanner, ".Name", 0, valid_symbols).token != RAZOR_MEMBER_DOT);
+
+    tree_sitter_razor_external_scanner_destroy(scanner);
+}
+
+// Error recovery can skip the closer of a context the scanner opened, and
+// the scanner drops such leftovers at the points where no context can be
+// open: where keyword-aware HTML text is valid outside of recovery, and at a
+// directive that starts a line during recovery
+static void test_recovery(void) {
+    bool open_block[EXTERNAL_TOKEN_COUNT] = {0};
+    open_block[CSHARP_CODE_BLOCK_START] = true;
+    bool recovering[EXTERNAL_TOKEN_COUNT];
+    for (unsigned token = 0; token < EXTERNAL_TOKEN_COUNT; token++) {
+        recovering[token] = true;
+    }
+    bool top_level_text[EXTERNAL_TOKEN_COUNT] = {0};
+    top_level_text[HTML_TEXT_CONTENT] = true;
+
+    RazorScanner *scanner = tree_sitter_razor_external_scanner_create();
+
+    // Back between top-level nodes: the contexts are left over
+    CHECK(scan_at(scanner, "@{", 0, open_block).token == CSHARP_CODE_BLOCK_START);
+    CHECK(scan_at(scanner, "@{", 0, open_block).token == CSHARP_CODE_BLOCK_START);
+    ScanResult result = scan_at(scanner, "text", 0, top_level_text);
+    CHECK(result.token == HTML_TEXT_CONTENT && result.end == 4);
+    CHECK(!in_csharp_context(scanner));
+
+    // A directive at the start of a line, indented or not, ends them
+    static const char *const RESYNC[] = {"\n@code {", "  @section Scripts {", "\r\n\t@page \"/\""};
+    for (unsigned i = 0; i < sizeof(RESYNC) / sizeof(RESYNC[0]); i++) {
+        CHECK(scan_at(scanner, "@{", 0, open_block).token == CSHARP_CODE_BLOCK_START);
+        result = scan_at(scanner, RESYNC[i], 0, recovering);
+        CHECK(result.token >= FIRST_DIRECTIVE_KEYWORD && result.token < EXTERNAL_TOKEN_COUNT);
+        CHECK(!in_csharp_context(scanner));
+    }
+
+    // One later in a line, or a statement keyword, does not
+    CHECK(scan_at(scanner, "@{", 0, open_block).token == CSHARP_CODE_BLOCK_START);
+    result = scan_at(scanner, "x = 1; @code {", 6, recovering);
+    CHECK(result.token == CODE_DIRECTIVE_KEYWORD && result.start == 7);
+    CHECK(in_csharp_context(scanner));
+    result = scan_at(scanner, "\n@if (x) {", 0, recovering);
+    CHECK(result.token == RAZOR_STATEMENT_START);
+    CHECK(in_csharp_context(scanner));
+
+    // Nor does a directive outside of recovery
+    tree_sitter_razor_external_scanner_deserialize(scanner, NULL, 0);
+    CHECK(scan_at(scanner, "@{", 0, open_block).token == CSHARP_CODE_BLOCK_START);
+    bool directives[EXTERNAL_TOKEN_COUNT] = {0};
+    for (unsigned token = FIRST_DIRECTIVE_KEYWORD; token < EXTERNAL_TOKEN_COUNT; token++) {
+        directives[token] = true;
+    }
+    CHECK(scan_at(scanner, "@code {", 0, directives).token == CODE_DIRECTIVE_KEYWORD);
+    CHECK(in_csharp_context(scanner));
+
+    tree_sitter_razor_external_scanner_destroy(scanner);
+}
+
+// Raw text comes in chunks
+static void test_raw_text_chunks(void) {
+    char script[8 * RAW_TEXT_CHUNK_MAX_LENGTH];
+    memset(script, ';', sizeof(script) - 1);
+    script[sizeof(script) - 1] = '\0';
+
+    bool valid_symbols[EXTERNAL_TOKEN_COUNT] = {0};
+    valid_symbols[SCRIPT_CONTENT] = true;
+
+    RazorScanner *scanner = tree_sitter_razor_external_scanner_create();
+    BenchLexer lexer;
+    bench_lexer_init(&lexer, script, (uint32_t)strlen(script));
+    CHECK(tree_sitter_razor_external_scanner_scan(scanner, &lexer.base, valid_symbols));
+    CHECK(lexer.base.result_symbol == SCRIPT_CONTENT);
+    CHECK(bench_lexer_token_end(&lexer) == RAZOR_LOOKAHEAD_LIMIT);
+    tree_sitter_razor_external_scanner_destroy(scanner);
+}
+
+// Raw text runs up to its own end tag, in any case, past a '<' that starts
+// something else, as in the html.txt corpus cases
+static void test_raw_text_end_tags(void) {
+    static const struct {
+        enum RazorTokenType token;
+        const char *input;
+        const char *content;
+    } CASES[] = {
+        {SCRIPT_CONTENT, "if (x < 10 && y > 5) { alert(\"<div>\"); }</script>",
+         "if (x < 10 && y > 5) { alert(\"<div>\"); }"},
+        {SCRIPT_CONTENT, "<!-- legacy --></div></SCRIPT>", "<!-- legacy --></div>"},
+        {SCRIPT_CONTENT, "a </scripts> b</script >", "a </scripts> b"},
+        {STYLE_CONTENT, "p > a { color: red; }</Style>", "p > a { color: red; }"},
+        {TITLE_CONTENT, "Home &amp; <b>away</title>", "Home &amp; <b>away"},
+        {TEXTAREA_CONTENT, "<p>draft</p>\n</textarea>", "<p>draft</p>\n"},
+    };
+
+    RazorScanner *scanner = tree_sitter_razor_external_scanner_create();
+    for (size_t i = 0; i < sizeof(CASES) / sizeof(CASES[0]); i++) {
+        bool valid_symbols[EXTERNAL_TOKEN_COUNT] = {0};
+        valid_symbols[CASES[i].token] = true;
+        ScanResult result = scan_at(scanner, CASES[i].input, 0, valid_symbols);
+        CHECK(result.token == CASES[i].token);
+        CHECK(result.start == 0);
+        CHECK(result.end == strlen(CASES[i].content));
+    }
+
+    // Nothing before the end tag is no token at all
+    bool valid_symbols[EXTERNAL_TOKEN_COUNT] = {0};
+    valid_symbols[SCRIPT_CONTENT] = true;
+    CHECK(scan_at(scanner, "</script>", 0, valid_symbols).token == EXTERNAL_TOKEN_COUNT);
+    tree_sitter_razor_external_scanner_destroy(scanner);
+}
+
+int main(void) {
+    test_deep_nesting();
+    test_alternating_nesting();
+    test_malformed_state();
+    test_large_csharp_state();
+    test_raw_text_chunks();
+    test_raw_text_end_tags();
+    test_at_keywords();
+    test_member_dot();
+    test_recovery();
+    printf("scanner tests passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,208 @@
+/**
+ * Directive summary tests
+ *
+ * Runs the directive summary (tree-sitter-razor-summary.h) over the Razor
+ * pages and views in test/samples and checks:
+ *
+ * - that the pass over the raw bytes finds exactly the expected directive
+ *   lines in each scope, and that every code block, section and statement
+ *   at the left margin is skipped up to its own closing brace, past
+ *   apostrophes, braces in markup and character literals of every form
+ * - that the parse of those lines gives one directive node of the expected
+ *   type for each of them
+ *
+ * Usage: summary_test [samples directory]
+ *
+ * Exits non-zero on the first failed check.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "tree-sitter-razor-summary.c"
+
+#include <stdio.h>
+
+const TSLanguage *tree_sitter_razor(void);
+
+#define CHECK(condition)                                                      \
+    do {                                                                      \
+        if (!(condition)) {                                                   \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            exit(EXIT_FAILURE);                                               \
+        }                                                                     \
+    } while (0)
+
+typedef struct {
+    const char *line;  // The directive line without its line break
+    const char *node;
+} ExpectedDirective;
+
+typedef struct {
+    const char *name;
+    // Directives in document order, ending with a NULL line. The first
+    // `leading_count` are those of the leading block.
+    ExpectedDirective directives[8];
+    uint32_t leading_count;
+} Sample;
+
+static const Sample SAMPLES[] = {
+    {
+        "Index.cshtml",
+        {
+            {"@model IndexViewModel", "razor_model_directive"},
+            {"@using System.Globalization", "razor_using_directive"},
+            {"@inject IStringLocalizer<IndexModel> Localizer", "razor_inject_directive"},
+            {NULL, NULL},
+        },
+        3,
+    },
+    {
+        "FetchData.razor",
+        {
+            {"@page \"/fetchdata\"", "razor_page_directive"},
+            {"@using BlazorApp.Data", "razor_using_directive"},
+            {"@inject WeatherForecastService ForecastService", "razor_inject_directive"},
+            {"@implements IDisposable", "razor_implements_directive"},
+            {"@attribute [StreamRendering]", "razor_attribute_directive"},
+            {"@rendermode InteractiveServer", "razor_rendermode_directive"},
+            {NULL, NULL},
+        },
+        4,
+    },
+};
+
+static char *read_sample(const char *directory, const char *name, uint32_t *length) {
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/%s", directory, name);
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    char *contents = NULL;
+    size_t size = 0;
+    size_t capacity = 0;
+    size_t read;
+    do {
+        if (capacity - size < 4096) {
+            capacity = capacity ? 2 * capacity : 16384;
+            contents = realloc(contents, capacity);
+            CHECK(contents);
+        }
+        read = fread(contents + size, 1, capacity - size - 1, file);
+        size += read;
+    } while (read > 0);
+    fclose(file);
+    contents[size] = '\0';
+    *length = (uint32_t)size;
+    return contents;
+}
+
+static uint32_t expected_count(const Sample *sample, TSRazorSummaryScope scope) {
+    if (scope == TSRazorSummaryLeading) {
+        return sample->leading_count;
+    }
+    uint32_t count = 0;
+    while (sample->directives[count].line) {
+        count++;
+    }
+    return count;
+}
+
+// The ranges from the pass over the raw bytes, one per directive line
+static void test_ranges(const Sample *sample, const char *source, uint32_t length, TSRazorSummaryScope scope) {
+    DirectiveScan scan = {.source = source, .length = length};
+    CHECK(find_directives(&scan, scope));
+    CHECK(scan.range_count == expected_count(sample, scope));
+
+    for (uint32_t i = 0; i < scan.range_count; i++) {
+        const TSRange *range = &scan.ranges[i];
+        const char *line = sample->directives[i].line;
+        size_t line_length = strlen(line);
+        CHECK(range->end_byte - range->start_byte == line_length + 1);
+        CHECK(memcmp(source + range->start_byte, line, line_length) == 0);
+        CHECK(source[range->end_byte - 1] == '\n');
+        CHECK(range->start_point.column == 0);
+        CHECK(range->end_point.row == range->start_point.row + 1);
+    }
+    free(scan.ranges);
+}
+
+// A block at the left margin in these samples runs up to the next line at
+// the margin that starts markup or a transition, so skipping it must end
+// just past the last '}' before that line
+static void test_blocks(const char *source, uint32_t length) {
+    DirectiveScan scan = {.source = source, .length = length};
+    static const char *const BLOCKS[] = {"@{", "@code", "@functions", "@section", "@if", "@foreach"};
+    uint32_t blocks = 0;
+
+    for (uint32_t i = 0; i < length; i = skip_past(&scan, i, "\n")) {
+        for (size_t j = 0; j < LENGTH_OF(BLOCKS); j++) {
+            if (!starts_with(&scan, i, BLOCKS[j])) {
+                continue;
+            }
+            uint32_t next = skip_past(&scan, i, "\n");
+            while (next < length && source[next] != '@' && source[next] != '<') {
+                next = skip_past(&scan, next, "\n");
+            }
+            uint32_t expected = next;
+            while (source[expected - 1] != '}') {
+                expected--;
+            }
+
+            uint32_t start = i + 1;
+            uint32_t end;
+            if (j == 0) {
+                end = skip_balanced(&scan, start, '{', '}');
+            } else if (j <= 3) {
+                end = skip_directive_block(&scan, word_end(&scan, start));
+            } else {
+                end = skip_statement(&scan, word_end(&scan, start));
+            }
+            CHECK(end == expected);
+            blocks++;
+        }
+    }
+    CHECK(blocks > 0);
+}
+
+// The parse of the directive lines, through the public API
+static void test_summary(TSParser *parser, const Sample *sample, const char *source, uint32_t length,
+                         TSRazorSummaryScope scope) {
+    TSRazorSummary summary;
+    CHECK(tree_sitter_razor_summarize(parser, source, length, scope, &summary));
+    CHECK(summary.directive_count == expected_count(sample, scope));
+
+    for (uint32_t i = 0; i < summary.directive_count; i++) {
+        TSNode node = summary.directives[i];
+        const char *line = sample->directives[i].line;
+        CHECK(strcmp(ts_node_type(node), sample->directives[i].node) == 0);
+        CHECK(memcmp(source + ts_node_start_byte(node), line, strlen(line)) == 0);
+        CHECK(!ts_node_has_error(node));
+    }
+    tree_sitter_razor_summary_delete(&summary);
+}
+
+int main(int argc, char **argv) {
+    const char *directory = argc > 1 ? argv[1] : "test/samples";
+
+    TSParser *parser = ts_parser_new();
+    CHECK(ts_parser_set_language(parser, tree_sitter_razor()));
+
+    for (size_t i = 0; i < LENGTH_OF(SAMPLES); i++) {
+        const Sample *sample = &SAMPLES[i];
+        uint32_t length;
+        char *source = read_sample(directory, sample->name, &length);
+
+        test_blocks(source, length);
+        test_ranges(sample, source, length, TSRazorSummaryLeading);
+        test_ranges(sample, source, length, TSRazorSummaryDocument);
+        test_summary(parser, sample, source, length, TSRazorSummaryLeading);
+        test_summary(parser, sample, source, length, TSRazorSummaryDocument);
+        free(source);
+    }
+
+    ts_parser_delete(parser);
+    printf("summary tests passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,140 @@
+/**
+ * WebAssembly startup benchmark
+ *
+ * Measures what a cold page load of a browser editor pays before the first
+ * highlight, with web-tree-sitter under Node:
+ *
+ *   - the size of the module as served: raw, gzip and brotli
+ *   - starting the web-tree-sitter runtime
+ *   - compiling and instantiating the grammar (Language.load)
+ *   - the first parse of a typical Blazor component, and a second one for
+ *     comparison
+ *
+ * Each sample loads the grammar again from its bytes. V8 can reuse the code
+ * it compiled for identical bytes earlier in the same process, so the first
+ * sample is the cold start and the median shows what is left once it does.
+ *
+ * Usage: node bench/wasm_bench.mjs [-n samples] [tree-sitter-razor.wasm]
+ * (`make wasm` builds the module; web-tree-sitter has to be installed)
+ */
+
+import { readFileSync } from "node:fs";
+import { performance } from "node:perf_hooks";
+import { brotliCompressSync, constants, gzipSync } from "node:zlib";
+
+// The component category of the parse benchmark (bench/corpus.h), seed 1
+const COMPONENT = `@page "/items/{Id:int}/edit1"
+@using System.ComponentModel.DataAnnotations
+@inject IItemService Items1
+@inject NavigationManager Navigation
+
+<PageTitle>Edit item 1</PageTitle>
+
+<h3>Edit</h3>
+
+@if (item is null)
+{
+    <p><em>Loading...</em></p>
+}
+else
+{
+    <EditForm Model="@item" OnValidSubmit="@Save">
+        <DataAnnotationsValidator />
+${[0, 1, 2, 3]
+  .map(
+    (i) => `        <div class="mb-3">
+            <label for="field${i}">Field ${i}</label>
+            <InputText id="field${i}" @bind-Value="item.Field${i}" />
+        </div>
+`,
+  )
+  .join("")}        <button type="submit" class="btn btn-primary" @onclick="Save">Save</button>
+    </EditForm>
+}
+
+@code {
+    [Parameter] public int Id { get; set; }
+
+    private Item? item;
+
+    protected override async Task OnInitializedAsync()
+    {
+        item = await Items.GetAsync(Id);
+    }
+
+    private async Task Save()
+    {
+        await Items.UpdateAsync(item!);
+        Navigation.NavigateTo("/items");
+    }
+}
+`;
+
+let samples = 10;
+let path = "tree-sitter-razor.wasm";
+for (let i = 2; i < process.argv.length; i++) {
+  if (process.argv[i] === "-n" && i + 1 < process.argv.length) {
+    samples = Math.max(1, Number.parseInt(process.argv[++i], 10) || 1);
+  } else {
+    path = process.argv[i];
+  }
+}
+
+let runtime;
+try {
+  runtime = await import("web-tree-sitter");
+} catch {
+  console.error("wasm_bench: web-tree-sitter is not installed (npm install --no-save web-tree-sitter)");
+  process.exit(1);
+}
+// 0.25 exports the classes by name, earlier versions the Parser class only
+const Parser = runtime.Parser ?? runtime.default;
+const Language = runtime.Language ?? Parser.Language;
+
+const bytes = readFileSync(path);
+const kilobytes = (length) => (length / 1024).toFixed(1);
+console.log(
+  `module: ${kilobytes(bytes.length)} KB, ` +
+    `${kilobytes(gzipSync(bytes, { level: 9 }).length)} KB gzip, ` +
+    `${kilobytes(brotliCompressSync(bytes, { params: { [constants.BROTLI_PARAM_QUALITY]: 11 } }).length)} KB brotli\n`,
+);
+
+let start = performance.now();
+await Parser.init();
+console.log(`runtime init: ${(performance.now() - start).toFixed(2)} ms\n`);
+
+const timings = { load: [], first: [], second: [] };
+for (let i = 0; i < samples; i++) {
+  start = performance.now();
+  const language = await Language.load(new Uint8Array(bytes));
+  timings.load.push(performance.now() - start);
+
+  const parser = new Parser();
+  parser.setLanguage(language);
+  for (const pass of ["first", "second"]) {
+    start = performance.now();
+    const tree = parser.parse(COMPONENT);
+    timings[pass].push(performance.now() - start);
+    if (tree.rootNode.hasError) {
+      console.error("wasm_bench: the component did not parse cleanly");
+    }
+    tree.delete();
+  }
+  parser.delete();
+}
+
+const percentile = (values, fraction) => {
+  const sorted = [...values].sort((a, b) => a - b);
+  return sorted[Math.min(sorted.length - 1, Math.floor(fraction * sorted.length))];
+};
+console.log(`${"step".padEnd(14)} ${"cold ms".padStart(9)} ${"p50 ms".padStart(9)}`);
+for (const [step, label] of [
+  ["load", "load"],
+  ["first", "first parse"],
+  ["second", "second parse"],
+]) {
+  console.log(
+    `${label.padEnd(14)} ${timings[step][0].toFixed(3).padStart(9)} ` +
+      `${percentile(timings[step], 0.5).toFixed(3).padStart(9)}`,
+  );
+}
@@ -13,16 +13,40 @@
         "src/parser.c",
       ],
       "variables": {
-        "has_scanner": "<!(node -p \"fs.existsSync('src/scanner.c')\")"
+        "has_scanner": "<!(node -p \"fs.existsSync('src/scanner.c')\")",
+        # parseAsync and parseFiles need the tree-sitter runtime, compiled in
+        # from the copy the `tree-sitter` package vendors when it is installed
+        "tree_sitter_lib": "<!(node -p \"(() => { try { const lib = path.join(path.dirname(require.resolve('tree-sitter/package.json')), 'vendor', 'tree-sitter', 'lib'); return fs.existsSync(path.join(lib, 'src', 'lib.c')) ? lib : ''; } catch (_) { return ''; } })()\")",
       },
       "conditions": [
         ["has_scanner=='true'", {
           "sources+": ["src/scanner.c"],
         }],
+        ["tree_sitter_lib!=''", {
+          "sources+": [
+            "bindings/node/parse.cc",
+            "<(tree_sitter_lib)/src/lib.c",
+          ],
+          "include_dirs+": [
+            "<(tree_sitter_lib)/include",
+          ],
+          "defines": [
+            "TREE_SITTER_RAZOR_NATIVE_PARSE",
+            "_POSIX_C_SOURCE=200112L",
+            "_DEFAULT_SOURCE",
+          ],
+        }],
         ["OS!='win'", {
           "cflags_c": [
             "-std=c11",
+            "-fvisibility=hidden",
+          ],
+          "cflags_cc": [
+            "-fvisibility=hidden",
           ],
+          "xcode_settings": {
+            "GCC_SYMBOLS_PRIVATE_EXTERN": "YES",
+          },
         }, { # OS == "win"
           "cflags_c": [
             "/std:c11",
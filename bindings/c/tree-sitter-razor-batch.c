@@ -0,0 +1,92 @@
+/**
+ * Multithreaded batch parsing (see tree_sitter/tree-sitter-razor-batch.h)
+ *
+ * Documents are handed out through a shared atomic cursor rather than split
+ * into fixed slices up front: .razor files vary from a few lines to
+ * thousands, and a thread that drew small ones simply comes back for more.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "tree_sitter/tree-sitter-razor-batch.h"
+#include "tree_sitter/tree-sitter-razor.h"
+
+#include <tree_sitter/api.h>
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+typedef struct {
+    const TSRazorBatchInput *inputs;
+    TSTree **trees;
+    uint32_t count;
+    atomic_uint_least32_t next;
+} BatchJob;
+
+static void *batch_worker(void *payload) {
+    BatchJob *job = (BatchJob *)payload;
+    TSParser *parser = ts_parser_new();
+    ts_parser_set_language(parser, tree_sitter_razor());
+
+    for (;;) {
+        uint32_t index = atomic_fetch_add_explicit(&job->next, 1, memory_order_relaxed);
+        if (index >= job->count) {
+            break;
+        }
+        const TSRazorBatchInput *input = &job->inputs[index];
+        job->trees[index] = ts_parser_parse_string(parser, NULL, input->contents, input->length);
+    }
+
+    ts_parser_delete(parser);
+    return NULL;
+}
+
+static uint32_t online_cpu_count(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (uint32_t)count : 1;
+}
+
+bool tree_sitter_razor_parse_batch(const TSRazorBatchInput *inputs, uint32_t count, uint32_t thread_count,
+                                   TSTree **trees) {
+    for (uint32_t i = 0; i < count; i++) {
+        trees[i] = NULL;
+    }
+
+    // Fail up front rather than in every worker
+    TSParser *probe = ts_parser_new();
+    bool compatible = ts_parser_set_language(probe, tree_sitter_razor());
+    ts_parser_delete(probe);
+    if (!compatible) {
+        return false;
+    }
+
+    if (thread_count == 0) {
+        thread_count = online_cpu_count();
+    }
+    if (thread_count > count) {
+        thread_count = count;
+    }
+
+    BatchJob job = {.inputs = inputs, .trees = trees, .count = count};
+    atomic_init(&job.next, 0);
+
+    // The calling thread is one of the workers. If a thread cannot be
+    // started, the ones that did (and the caller) pick up its share.
+    uint32_t spawned = 0;
+    pthread_t *threads = thread_count > 1 ? malloc(sizeof(pthread_t) * (thread_count - 1)) : NULL;
+    if (threads) {
+        while (spawned < thread_count - 1 && pthread_create(&threads[spawned], NULL, batch_worker, &job) == 0) {
+            spawned++;
+        }
+    }
+
+    batch_worker(&job);
+
+    for (uint32_t i = 0; i < spawned; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    free(threads);
+    return true;
+}
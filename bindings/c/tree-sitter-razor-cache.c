@@ -0,0 +1,191 @@
+/**
+ * Binary parse tree caches (see tree_sitter/tree-sitter-razor-cache.h)
+ *
+ * A cache is the pre-order list of a tree's visible nodes, each with the
+ * size of its subtree, so a mapped file can be walked in place: a node's
+ * first child is the next record and its next sibling is one subtree
+ * further on.
+ */
+
+#include "tree_sitter/tree-sitter-razor-cache.h"
+
+#include <tree_sitter/api.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325u
+#define FNV_PRIME 0x100000001b3u
+
+static uint64_t fnv1a(uint64_t hash, const char *bytes, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+uint64_t tree_sitter_razor_cache_hash(const char *source, uint32_t length) {
+    return fnv1a(FNV_OFFSET_BASIS, source, length);
+}
+
+// Every name with its terminating NUL, symbols first, so that any change
+// to which ID means what changes the hash
+static uint64_t grammar_hash(const TSLanguage *language) {
+    uint64_t hash = FNV_OFFSET_BASIS;
+    uint32_t symbol_count = ts_language_symbol_count(language);
+    for (uint32_t symbol = 0; symbol < symbol_count; symbol++) {
+        const char *name = ts_language_symbol_name(language, (TSSymbol)symbol);
+        hash = name ? fnv1a(hash, name, strlen(name) + 1) : fnv1a(hash, "", 1);
+    }
+    uint32_t field_count = ts_language_field_count(language);
+    for (uint32_t field = 1; field <= field_count; field++) {
+        const char *name = ts_language_field_name_for_id(language, (TSFieldId)field);
+        hash = name ? fnv1a(hash, name, strlen(name) + 1) : fnv1a(hash, "", 1);
+    }
+    return hash;
+}
+
+// The header fields that depend only on the grammar
+static void fill_grammar_header(TSRazorCacheHeader *header, const TSLanguage *language) {
+    memset(header, 0, sizeof(*header));
+    header->magic = TS_RAZOR_CACHE_MAGIC;
+    header->format = TS_RAZOR_CACHE_FORMAT;
+    header->abi_version = (uint16_t)ts_language_abi_version(language);
+    const TSLanguageMetadata *metadata = ts_language_metadata(language);
+    if (metadata) {
+        header->grammar_version[0] = metadata->major_version;
+        header->grammar_version[1] = metadata->minor_version;
+        header->grammar_version[2] = metadata->patch_version;
+    }
+    header->symbol_count = ts_language_symbol_count(language);
+    header->field_count = ts_language_field_count(language);
+    header->grammar_hash = grammar_hash(language);
+}
+
+static TSRazorCacheNode encode_node(TSNode node, TSFieldId field, uint32_t parent) {
+    TSPoint start = ts_node_start_point(node);
+    TSPoint end = ts_node_end_point(node);
+    return (TSRazorCacheNode){
+        .symbol = ts_node_symbol(node),
+        .field = field,
+        .flags = (uint16_t)((ts_node_is_named(node) ? TSRazorCacheNamed : 0) |
+                            (ts_node_is_extra(node) ? TSRazorCacheExtra : 0) |
+                            (ts_node_is_missing(node) ? TSRazorCacheMissing : 0) |
+                            (ts_node_has_error(node) ? TSRazorCacheHasError : 0)),
+        .start_byte = ts_node_start_byte(node),
+        .end_byte = ts_node_end_byte(node),
+        .start_row = start.row,
+        .start_column = start.column,
+        .end_row = end.row,
+        .end_column = end.column,
+        .parent = parent,
+        .descendant_count = 1,
+    };
+}
+
+void *tree_sitter_razor_cache_encode(const TSTree *tree, const char *source, uint32_t length, size_t *size) {
+    size_t capacity = 256;
+    char *buffer = malloc(sizeof(TSRazorCacheHeader) + capacity * sizeof(TSRazorCacheNode));
+    if (!buffer) {
+        return NULL;
+    }
+    TSRazorCacheNode *nodes = (TSRazorCacheNode *)(buffer + sizeof(TSRazorCacheHeader));
+    uint32_t count = 0;
+
+    // Subtree sizes are filled in on the way back up, once every
+    // descendant has been written
+    TSTreeCursor cursor = ts_tree_cursor_new(ts_tree_root_node(tree));
+    uint32_t parent = TS_RAZOR_CACHE_NONE;
+    for (;;) {
+        if (count == capacity) {
+            capacity *= 2;
+            char *grown = realloc(buffer, sizeof(TSRazorCacheHeader) + capacity * sizeof(TSRazorCacheNode));
+            if (!grown) {
+                ts_tree_cursor_delete(&cursor);
+                free(buffer);
+                return NULL;
+            }
+            buffer = grown;
+            nodes = (TSRazorCacheNode *)(buffer + sizeof(TSRazorCacheHeader));
+        }
+        uint32_t index = count++;
+        nodes[index] = encode_node(ts_tree_cursor_current_node(&cursor), ts_tree_cursor_current_field_id(&cursor), parent);
+
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            parent = index;
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                goto done;
+            }
+            nodes[parent].descendant_count = count - parent;
+            parent = nodes[parent].parent;
+        }
+    }
+done:
+    ts_tree_cursor_delete(&cursor);
+
+    TSRazorCacheHeader *header = (TSRazorCacheHeader *)buffer;
+    fill_grammar_header(header, ts_tree_language(tree));
+    header->node_count = count;
+    header->content_hash = tree_sitter_razor_cache_hash(source, length);
+    header->content_length = length;
+
+    *size = sizeof(TSRazorCacheHeader) + (size_t)count * sizeof(TSRazorCacheNode);
+    return buffer;
+}
+
+// Every subtree has to fit inside its parent's, so that navigation never
+// leaves the node array, however the file was damaged
+static bool nodes_are_consistent(const TSRazorCacheNode *nodes, uint32_t count) {
+    if (count == 0 || nodes[0].parent != TS_RAZOR_CACHE_NONE || nodes[0].descendant_count != count) {
+        return false;
+    }
+    for (uint32_t index = 1; index < count; index++) {
+        const TSRazorCacheNode *node = &nodes[index];
+        if (node->parent >= index || index - node->parent >= nodes[node->parent].descendant_count ||
+            node->descendant_count == 0 ||
+            node->descendant_count > nodes[node->parent].descendant_count - (index - node->parent)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool tree_sitter_razor_cache_open(const void *data, size_t size, const TSLanguage *language, const char *source,
+                                  uint32_t length, TSRazorCache *cache) {
+    if (size < sizeof(TSRazorCacheHeader) || (uintptr_t)data % 8 != 0) {
+        return false;
+    }
+
+    const TSRazorCacheHeader *header = (const TSRazorCacheHeader *)data;
+    if (header->magic != TS_RAZOR_CACHE_MAGIC || header->format != TS_RAZOR_CACHE_FORMAT) {
+        return false;
+    }
+
+    TSRazorCacheHeader expected;
+    fill_grammar_header(&expected, language);
+    if (header->abi_version != expected.abi_version ||
+        memcmp(header->grammar_version, expected.grammar_version, sizeof(expected.grammar_version)) != 0 ||
+        header->symbol_count != expected.symbol_count || header->field_count != expected.field_count ||
+        header->grammar_hash != expected.grammar_hash) {
+        return false;
+    }
+
+    if (source && (header->content_length != length ||
+                   header->content_hash != tree_sitter_razor_cache_hash(source, length))) {
+        return false;
+    }
+
+    const TSRazorCacheNode *nodes = (const TSRazorCacheNode *)(header + 1);
+    if (header->node_count > (size - sizeof(TSRazorCacheHeader)) / sizeof(TSRazorCacheNode) ||
+        !nodes_are_consistent(nodes, header->node_count)) {
+        return false;
+    }
+
+    cache->header = header;
+    cache->nodes = nodes;
+    return true;
+}
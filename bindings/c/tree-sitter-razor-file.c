@@ -0,0 +1,111 @@
+/**
+ * Memory-mapped document parsing (see tree_sitter/tree-sitter-razor-file.h)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "tree_sitter/tree-sitter-razor-file.h"
+
+#include <tree_sitter/api.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static void detect_byte_order_mark(TSRazorMappedFile *file) {
+    const unsigned char *bytes = (const unsigned char *)file->contents;
+    unsigned skip = 0;
+
+    if (file->length >= 3 && bytes[0] == 0xEF && bytes[1] == 0xBB && bytes[2] == 0xBF) {
+        skip = 3;
+    } else if (file->length >= 2 && bytes[0] == 0xFF && bytes[1] == 0xFE) {
+        file->encoding = TSRazorFileUTF16LE;
+        skip = 2;
+    } else if (file->length >= 2 && bytes[0] == 0xFE && bytes[1] == 0xFF) {
+        file->encoding = TSRazorFileUTF16BE;
+        skip = 2;
+    }
+
+    file->contents += skip;
+    file->length -= skip;
+}
+
+bool tree_sitter_razor_file_map(const char *path, TSRazorMappedFile *file) {
+    memset(file, 0, sizeof(*file));
+    file->contents = "";
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        int error = errno;
+        close(fd);
+        errno = error;
+        return false;
+    }
+    if ((uint64_t)info.st_size > UINT32_MAX) {
+        close(fd);
+        errno = EFBIG;
+        return false;
+    }
+
+    // Empty files cannot be mapped, but are valid documents
+    if (info.st_size > 0) {
+        void *mapping = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            int error = errno;
+            close(fd);
+            errno = error;
+            return false;
+        }
+#ifdef POSIX_MADV_SEQUENTIAL
+        posix_madvise(mapping, (size_t)info.st_size, POSIX_MADV_SEQUENTIAL);
+#endif
+        file->mapping = mapping;
+        file->mapping_length = (size_t)info.st_size;
+        file->contents = mapping;
+        file->length = (uint32_t)info.st_size;
+    }
+    close(fd);
+
+    detect_byte_order_mark(file);
+    return true;
+}
+
+void tree_sitter_razor_file_unmap(TSRazorMappedFile *file) {
+    if (file->mapping) {
+        munmap(file->mapping, file->mapping_length);
+    }
+    memset(file, 0, sizeof(*file));
+    file->contents = "";
+}
+
+// The whole document is already in memory, so every read hands out the rest
+// of it and the parser never has to come back for another chunk
+static const char *read_mapped(void *payload, uint32_t byte_index, TSPoint position, uint32_t *bytes_read) {
+    (void)position;
+    const TSRazorMappedFile *file = (const TSRazorMappedFile *)payload;
+    if (byte_index >= file->length) {
+        *bytes_read = 0;
+        return "";
+    }
+    *bytes_read = file->length - byte_index;
+    return file->contents + byte_index;
+}
+
+TSTree *tree_sitter_razor_file_parse(TSParser *parser, const TSTree *old_tree, const TSRazorMappedFile *file) {
+    TSInput input = {
+        .payload = (void *)file,
+        .read = read_mapped,
+        .encoding = file->encoding == TSRazorFileUTF16LE   ? TSInputEncodingUTF16LE
+                    : file->encoding == TSRazorFileUTF16BE ? TSInputEncodingUTF16BE
+                                                           : TSInputEncodingUTF8,
+    };
+    return ts_parser_parse(parser, old_tree, input);
+}
@@ -0,0 +1,157 @@
+/**
+ * Streaming parsing of large documents (see tree_sitter/tree-sitter-razor-stream.h)
+ *
+ * compilation_unit is a flat repeat of top-level nodes, each of which starts
+ * in markup with nothing open, so the parse can start over at any boundary
+ * between two of them. The document is parsed a window at a time through an
+ * included range that starts at such a boundary, which keeps the byte
+ * offsets and points of every tree relative to the whole document.
+ */
+
+#include "tree_sitter/tree-sitter-razor-stream.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_WINDOW_SIZE (1u << 20)
+
+// Top-level nodes at the end of a window that are parsed again with the next
+#define HELD_BACK_NODES 2
+
+// The part of the document that has been read but not handed out
+typedef struct {
+    char *data;
+    uint32_t length;
+    uint32_t capacity;
+    uint32_t start_byte;  // Document offset of data[0]
+    TSPoint start_point;
+    bool at_end;
+} StreamWindow;
+
+static uint32_t saturating_add(uint32_t a, uint32_t b) {
+    return a > UINT32_MAX - b ? UINT32_MAX : a + b;
+}
+
+// Read until the window holds `length` bytes or the document has ended.
+// Fails if memory runs out or the document goes on past what a tree can
+// address.
+static bool fill_window(StreamWindow *window, TSRazorStreamInput *input, uint32_t length) {
+    if (length > UINT32_MAX - window->start_byte) {
+        length = UINT32_MAX - window->start_byte;
+    }
+    if (length > window->capacity) {
+        char *data = realloc(window->data, length);
+        if (!data) {
+            return false;
+        }
+        window->data = data;
+        window->capacity = length;
+    }
+
+    while (!window->at_end && window->length < length) {
+        uint32_t count = input->read(input->payload, window->data + window->length, length - window->length);
+        window->length += count;
+        window->at_end = count == 0;
+    }
+    return window->at_end || window->length < UINT32_MAX - window->start_byte;
+}
+
+// Drop the first `length` bytes, which have been handed out, keeping the
+// point of the new start in step. Columns count bytes, as in tree-sitter.
+static void advance_window(StreamWindow *window, uint32_t length) {
+    const char *line = window->data;
+    const char *end = window->data + length;
+    const char *newline;
+    while ((newline = memchr(line, '\n', (size_t)(end - line)))) {
+        window->start_point.row++;
+        line = newline + 1;
+    }
+    window->start_point.column = line == window->data ? window->start_point.column + length : (uint32_t)(end - line);
+
+    memmove(window->data, end, window->length - length);
+    window->length -= length;
+    window->start_byte += length;
+}
+
+// The parser only ever reads inside the included range, which starts at the
+// window, and sees the end of the document where the window ends
+static const char *read_window(void *payload, uint32_t byte_index, TSPoint position, uint32_t *bytes_read) {
+    (void)position;
+    const StreamWindow *window = (const StreamWindow *)payload;
+    uint32_t offset = byte_index - window->start_byte;
+    if (byte_index < window->start_byte || offset >= window->length) {
+        *bytes_read = 0;
+        return "";
+    }
+    *bytes_read = window->length - offset;
+    return window->data + offset;
+}
+
+bool tree_sitter_razor_parse_stream(TSParser *parser, TSRazorStreamInput input, uint32_t window_size,
+                                    TSRazorStreamCallback callback, void *payload) {
+    if (window_size == 0) {
+        window_size = DEFAULT_WINDOW_SIZE;
+    }
+
+    StreamWindow window = {0};
+    uint32_t wanted = window_size;
+    bool ok = true;
+    bool stopped = false;
+
+    while (!stopped) {
+        if (!fill_window(&window, &input, wanted)) {
+            ok = false;
+            break;
+        }
+
+        TSRange range = {
+            .start_point = window.start_point,
+            .end_point = {UINT32_MAX, UINT32_MAX},
+            .start_byte = window.start_byte,
+            .end_byte = UINT32_MAX,
+        };
+        ts_parser_set_included_ranges(parser, &range, 1);
+        TSInput source = {.payload = &window, .read = read_window, .encoding = TSInputEncodingUTF8};
+        TSTree *tree = ts_parser_parse(parser, NULL, source);
+        if (!tree) {
+            ok = false;
+            break;
+        }
+
+        // Only the end of the document is known to be final
+        TSNode root = ts_tree_root_node(tree);
+        uint32_t count = ts_node_child_count(root);
+        uint32_t held_back = window.at_end ? 0 : HELD_BACK_NODES;
+        uint32_t handed_out = window.start_byte;
+        if (count > held_back) {
+            TSTreeCursor cursor = ts_tree_cursor_new(root);
+            ts_tree_cursor_goto_first_child(&cursor);
+            for (uint32_t i = 0; i < count - held_back && !stopped; i++) {
+                TSNode node = ts_tree_cursor_current_node(&cursor);
+                const char *text = window.data + (ts_node_start_byte(node) - window.start_byte);
+                stopped = !callback(payload, node, text);
+                handed_out = ts_node_end_byte(node);
+                ts_tree_cursor_goto_next_sibling(&cursor);
+            }
+            ts_tree_cursor_delete(&cursor);
+        }
+        ts_tree_delete(tree);
+
+        if (window.at_end) {
+            break;
+        }
+
+        // Read another window's worth past what is held back, or double the
+        // window if nothing could be handed out
+        if (handed_out > window.start_byte) {
+            advance_window(&window, handed_out - window.start_byte);
+            wanted = saturating_add(window.length, window_size);
+        } else {
+            wanted = saturating_add(window.length, window.length > window_size ? window.length : window_size);
+        }
+    }
+
+    ts_parser_set_included_ranges(parser, NULL, 0);
+    free(window.data);
+    return ok;
+}
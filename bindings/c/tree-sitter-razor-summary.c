@@ -0,0 +1,503 @@
+/**
+ * Directive summaries (see tree_sitter/tree-sitter-razor-summary.h)
+ *
+ * The directive lines are found by a pass over the raw bytes that knows just
+ * enough Razor to step over everything else: comments, transitions that are
+ * not directives, and C# bodies, whose extent is found by counting braces or
+ * parentheses outside strings, comments and the markup inside those bodies.
+ * The parser then only sees those lines, through one included range each, so
+ * the tree it builds is a short list of directives with offsets into the
+ * whole document.
+ */
+
+#include "tree_sitter/tree-sitter-razor-summary.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Directives that take the rest of their line
+static const char *const LINE_DIRECTIVES[] = {
+    "page",     "model",     "using",      "inject",    "inherits",           "namespace",
+    "layout",   "attribute", "implements", "typeparam", "preservewhitespace", "rendermode",
+    "addTagHelper", "removeTagHelper", "tagHelperPrefix",
+};
+
+// Statements whose parentheses and braces are skipped, with the clauses
+// that can follow their closing brace
+static const char *const STATEMENTS[] = {"if", "for", "foreach", "while", "switch", "lock", "using", "try", "do"};
+static const char *const CONTINUATIONS[] = {"else", "catch", "finally", "while"};
+
+// The nodes of LINE_DIRECTIVES, which are the only ones parsed
+static const char *const DIRECTIVE_NODES[] = {
+    "razor_page_directive",       "razor_model_directive",          "razor_using_directive",
+    "razor_inject_directive",     "razor_inherits_directive",       "razor_namespace_directive",
+    "razor_layout_directive",     "razor_attribute_directive",      "razor_implements_directive",
+    "razor_typeparam_directive",  "razor_preservewhitespace_directive", "razor_rendermode_directive",
+    "razor_addtaghelper_directive", "razor_removetaghelper_directive", "razor_taghelperprefix_directive",
+};
+
+// Elements that have no end tag
+static const char *const VOID_ELEMENTS[] = {
+    "area", "base", "br", "col", "embed", "hr", "img", "input", "link", "meta", "source", "track", "wbr",
+};
+
+#define LENGTH_OF(array) (sizeof(array) / sizeof(array[0]))
+
+typedef struct {
+    const char *source;
+    uint32_t length;
+    TSRange *ranges;
+    uint32_t range_count;
+    uint32_t range_capacity;
+    // Where the last range ended, for counting rows from there
+    uint32_t point_byte;
+    TSPoint point;
+} DirectiveScan;
+
+static bool is_word_char(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' ||
+           (unsigned char)c >= 0x80;
+}
+
+static bool is_space(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v'; }
+
+static uint32_t skip_space(const DirectiveScan *scan, uint32_t i) {
+    while (i < scan->length && is_space(scan->source[i])) {
+        i++;
+    }
+    return i;
+}
+
+static uint32_t word_end(const DirectiveScan *scan, uint32_t i) {
+    while (i < scan->length && is_word_char(scan->source[i])) {
+        i++;
+    }
+    return i;
+}
+
+static bool is_word(const DirectiveScan *scan, uint32_t start, uint32_t end, const char *word) {
+    size_t length = strlen(word);
+    return end - start == length && memcmp(scan->source + start, word, length) == 0;
+}
+
+static bool is_any_word(const DirectiveScan *scan, uint32_t start, uint32_t end, const char *const *words,
+                        size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (is_word(scan, start, end, words[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Whether the word from `start` to `end` is `word`, ignoring case as HTML
+// tag names do
+static bool is_word_ignoring_case(const DirectiveScan *scan, uint32_t start, uint32_t end, const char *word) {
+    if (end - start != strlen(word)) {
+        return false;
+    }
+    for (uint32_t i = start; i < end; i++) {
+        char c = scan->source[i];
+        if ((c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c) != word[i - start]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool starts_with(const DirectiveScan *scan, uint32_t i, const char *text) {
+    size_t length = strlen(text);
+    return scan->length - i >= length && memcmp(scan->source + i, text, length) == 0;
+}
+
+// The index just past the first `terminator` at or after `i`, or the end of
+// the document, as for an unterminated comment in the scanner
+static uint32_t skip_past(const DirectiveScan *scan, uint32_t i, const char *terminator) {
+    size_t length = strlen(terminator);
+    while (i < scan->length) {
+        const char *found = memchr(scan->source + i, terminator[0], scan->length - i);
+        if (!found) {
+            break;
+        }
+        i = (uint32_t)(found - scan->source);
+        if (starts_with(scan, i, terminator)) {
+            return i + (uint32_t)length;
+        }
+        i++;
+    }
+    return scan->length;
+}
+
+// Skip a string or character literal whose opening quote is at `i`.
+// Verbatim strings double their quotes instead of escaping them.
+static uint32_t skip_literal(const DirectiveScan *scan, uint32_t i, bool verbatim) {
+    char quote = scan->source[i++];
+    while (i < scan->length) {
+        char c = scan->source[i++];
+        if (c == quote) {
+            if (verbatim && i < scan->length && scan->source[i] == quote) {
+                i++;
+                continue;
+            }
+            return i;
+        }
+        if (c == '\\' && !verbatim) {
+            i++;
+        } else if (c == '\n' && !verbatim) {
+            return i;
+        }
+    }
+    return scan->length;
+}
+
+// Whether the quote at `i` opens a character literal: one character or an
+// escape sequence, then the closing quote. Any other quote is an apostrophe
+// in text, as in "Don't".
+static bool is_char_literal(const DirectiveScan *scan, uint32_t i) {
+    uint32_t j = i + 1;
+    if (j >= scan->length || scan->source[j] == '\'' || scan->source[j] == '\n') {
+        return false;
+    }
+    if (scan->source[j] == '\\') {
+        // The longest escape, \U followed by eight digits, is ten characters
+        for (j += 2; j < scan->length && j <= i + 11; j++) {
+            if (scan->source[j] == '\'') {
+                return true;
+            }
+            if (scan->source[j] == '\n') {
+                return false;
+            }
+        }
+        return false;
+    }
+    // Past the continuation bytes of a UTF-8 character
+    for (j++; j < scan->length && ((unsigned char)scan->source[j] & 0xC0) == 0x80; j++) {}
+    return j < scan->length && scan->source[j] == '\'';
+}
+
+static uint32_t skip_balanced(const DirectiveScan *scan, uint32_t i, char open, char close);
+static uint32_t skip_statement(const DirectiveScan *scan, uint32_t i);
+
+// Skip an element inside a code block, from its '<' to just past the tag
+// that ends it. Its text is not C#, so quotes and braces in it do not
+// count, but the code blocks, expressions and statements in it do.
+static uint32_t skip_markup(const DirectiveScan *scan, uint32_t i) {
+    uint32_t name_start = i + 1;
+    uint32_t name_end = word_end(scan, name_start);
+    char name[32];
+    if (name_end == name_start || name_end - name_start >= sizeof(name)) {
+        return i + 1;
+    }
+    for (uint32_t j = name_start; j < name_end; j++) {
+        char c = scan->source[j];
+        name[j - name_start] = c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+    }
+    name[name_end - name_start] = '\0';
+    bool is_void = false;
+    for (size_t j = 0; j < LENGTH_OF(VOID_ELEMENTS); j++) {
+        is_void = is_void || strcmp(name, VOID_ELEMENTS[j]) == 0;
+    }
+
+    uint32_t depth = 0;
+    while (i < scan->length) {
+        char c = scan->source[i];
+        if (c == '<') {
+            bool closing = i + 1 < scan->length && scan->source[i + 1] == '/';
+            uint32_t start = i + 1 + closing;
+            uint32_t end = word_end(scan, start);
+            if (is_word_ignoring_case(scan, start, end, name)) {
+                uint32_t tag_end = skip_past(scan, end, ">");
+                bool self_closing = !closing && scan->source[tag_end - 2] == '/';
+                if (closing) {
+                    if (depth <= 1) {
+                        return tag_end;
+                    }
+                    depth--;
+                } else if (self_closing || is_void) {
+                    if (depth == 0) {
+                        return tag_end;
+                    }
+                } else {
+                    depth++;
+                }
+                i = tag_end;
+                continue;
+            }
+            if (starts_with(scan, i, "<!--")) {
+                i = skip_past(scan, i + 4, "-->");
+                continue;
+            }
+        } else if (c == '@' && i + 1 < scan->length) {
+            uint32_t start = i + 1;
+            uint32_t end = word_end(scan, start);
+            char next = scan->source[start];
+            if (next == '{') {
+                i = skip_balanced(scan, start, '{', '}');
+                continue;
+            } else if (next == '(') {
+                i = skip_balanced(scan, start, '(', ')');
+                continue;
+            } else if (next == '*') {
+                i = skip_past(scan, start + 1, "*@");
+                continue;
+            } else if (is_any_word(scan, start, end, STATEMENTS, LENGTH_OF(STATEMENTS))) {
+                i = skip_statement(scan, end);
+                continue;
+            }
+        }
+        i++;
+    }
+    return scan->length;
+}
+
+// Skip from the `open` bracket at `i` to just past the one that closes it.
+// Brackets inside strings, character literals and comments do not count,
+// and neither do those in the markup of a code block.
+static uint32_t skip_balanced(const DirectiveScan *scan, uint32_t i, char open, char close) {
+    uint32_t depth = 0;
+    // The last character of C# before `i`, to tell where a statement starts
+    char last = '\0';
+    while (i < scan->length) {
+        char c = scan->source[i];
+        bool statement_start = last == '{' || last == '}' || last == ';';
+        if (c == open) {
+            depth++;
+        } else if (c == close) {
+            if (--depth == 0) {
+                return i + 1;
+            }
+        } else if (c == '"' || (c == '\'' && is_char_literal(scan, i))) {
+            i = skip_literal(scan, i, false);
+            last = c;
+            continue;
+        } else if (open == '{' && c == '<' && statement_start && i + 1 < scan->length &&
+                   is_word_char(scan->source[i + 1])) {
+            // The element is a statement of its own
+            i = skip_markup(scan, i);
+            last = ';';
+            continue;
+        } else if (open == '{' && statement_start && starts_with(scan, i, "@:")) {
+            // A line of text
+            i = skip_past(scan, i, "\n");
+            last = ';';
+            continue;
+        } else if (c == '@' && i + 1 < scan->length && scan->source[i + 1] == '<') {
+            // A template, @<p>...</p>
+            i = skip_markup(scan, i + 1);
+            last = '>';
+            continue;
+        } else if ((c == '@' || c == '$') && i + 1 < scan->length && scan->source[i + 1] == '"') {
+            i = skip_literal(scan, i + 1, c == '@');
+            last = '"';
+            continue;
+        } else if (starts_with(scan, i, "//")) {
+            i = skip_past(scan, i, "\n");
+            continue;
+        } else if (starts_with(scan, i, "/*")) {
+            i = skip_past(scan, i + 2, "*/");
+            continue;
+        } else if (starts_with(scan, i, "@*")) {
+            i = skip_past(scan, i + 2, "*@");
+            continue;
+        }
+        if (!is_space(c)) {
+            last = c;
+        }
+        i++;
+    }
+    return scan->length;
+}
+
+// Skip a statement from just past its keyword: its condition, its block,
+// and any else, catch, finally or do-while clauses after it
+static uint32_t skip_statement(const DirectiveScan *scan, uint32_t i) {
+    for (;;) {
+        i = skip_space(scan, i);
+        if (i < scan->length && scan->source[i] == '(') {
+            i = skip_balanced(scan, i, '(', ')');
+            i = skip_space(scan, i);
+        }
+        if (i >= scan->length || scan->source[i] != '{') {
+            return i;
+        }
+        i = skip_balanced(scan, i, '{', '}');
+
+        uint32_t start = skip_space(scan, i);
+        uint32_t end = word_end(scan, start);
+        if (!is_any_word(scan, start, end, CONTINUATIONS, LENGTH_OF(CONTINUATIONS))) {
+            return i;
+        }
+        i = end;
+        if (is_word(scan, start, end, "else")) {
+            uint32_t next = skip_space(scan, i);
+            if (is_word(scan, next, word_end(scan, next), "if")) {
+                i = next + 2;
+            }
+        }
+    }
+}
+
+// Skip to and over the block that follows a @code, @functions or @section
+// keyword, past the section's name
+static uint32_t skip_directive_block(const DirectiveScan *scan, uint32_t i) {
+    i = word_end(scan, skip_space(scan, i));
+    i = skip_space(scan, i);
+    if (i < scan->length && scan->source[i] == '{') {
+        i = skip_balanced(scan, i, '{', '}');
+    }
+    return i;
+}
+
+static TSPoint point_at(DirectiveScan *scan, uint32_t byte) {
+    const char *line = scan->source + scan->point_byte;
+    const char *end = scan->source + byte;
+    const char *newline;
+    while ((newline = memchr(line, '\n', (size_t)(end - line)))) {
+        scan->point.row++;
+        scan->point.column = 0;
+        line = newline + 1;
+    }
+    scan->point.column += (uint32_t)(end - line);
+    scan->point_byte = byte;
+    return scan->point;
+}
+
+static bool add_range(DirectiveScan *scan, uint32_t start, uint32_t end) {
+    if (scan->range_count == scan->range_capacity) {
+        uint32_t capacity = scan->range_capacity ? 2 * scan->range_capacity : 16;
+        TSRange *ranges = realloc(scan->ranges, capacity * sizeof(TSRange));
+        if (!ranges) {
+            return false;
+        }
+        scan->ranges = ranges;
+        scan->range_capacity = capacity;
+    }
+    TSRange *range = &scan->ranges[scan->range_count++];
+    range->start_byte = start;
+    range->start_point = point_at(scan, start);
+    range->end_byte = end;
+    range->end_point = point_at(scan, end);
+    return true;
+}
+
+// Collect a range for every directive line, from its '@' through its line
+// break. In leading scope the search stops at the first markup.
+static bool find_directives(DirectiveScan *scan, TSRazorSummaryScope scope) {
+    uint32_t i = 0;
+    while (i < scan->length) {
+        char c = scan->source[i];
+        if (is_space(c)) {
+            i++;
+        } else if (starts_with(scan, i, "@*")) {
+            i = skip_past(scan, i + 2, "*@");
+        } else if (starts_with(scan, i, "<!--")) {
+            i = skip_past(scan, i + 4, "-->");
+        } else if (c == '@' && (i == 0 || !is_word_char(scan->source[i - 1]))) {
+            // An '@' after a word character is part of an email address
+            uint32_t start = i + 1;
+            uint32_t end = word_end(scan, start);
+            char next = start < scan->length ? scan->source[start] : '\0';
+            bool statement = is_any_word(scan, start, end, STATEMENTS, LENGTH_OF(STATEMENTS));
+            if (is_word(scan, start, end, "using")) {
+                // @using (...) is a statement, @using Namespace a directive
+                uint32_t after = skip_space(scan, end);
+                statement = after < scan->length && scan->source[after] == '(';
+            }
+
+            if (!statement && is_any_word(scan, start, end, LINE_DIRECTIVES, LENGTH_OF(LINE_DIRECTIVES))) {
+                uint32_t line_end = skip_past(scan, end, "\n");
+                if (!add_range(scan, i, line_end)) {
+                    return false;
+                }
+                i = line_end;
+            } else if (is_word(scan, start, end, "code") || is_word(scan, start, end, "functions") ||
+                       is_word(scan, start, end, "section")) {
+                i = skip_directive_block(scan, end);
+            } else if (statement) {
+                i = skip_statement(scan, end);
+            } else if (next == '{') {
+                i = skip_balanced(scan, start, '{', '}');
+            } else if (scope == TSRazorSummaryLeading) {
+                break;
+            } else if (next == '(') {
+                i = skip_balanced(scan, start, '(', ')');
+            } else {
+                // An implicit expression, or the @@ escape
+                i = next == '@' ? start + 1 : end;
+            }
+        } else if (scope == TSRazorSummaryLeading) {
+            break;
+        } else {
+            i++;
+        }
+    }
+    return true;
+}
+
+static bool is_directive(TSSymbol symbol, const TSSymbol *directive_symbols) {
+    for (size_t i = 0; i < LENGTH_OF(DIRECTIVE_NODES); i++) {
+        if (symbol == directive_symbols[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool tree_sitter_razor_summarize(TSParser *parser, const char *source, uint32_t length, TSRazorSummaryScope scope,
+                                 TSRazorSummary *summary) {
+    memset(summary, 0, sizeof(*summary));
+
+    DirectiveScan scan = {.source = source, .length = length};
+    if (!find_directives(&scan, scope)) {
+        free(scan.ranges);
+        return false;
+    }
+    // No ranges at all would mean the whole document to the parser
+    if (scan.range_count == 0) {
+        return true;
+    }
+
+    bool ok = ts_parser_set_included_ranges(parser, scan.ranges, scan.range_count);
+    TSTree *tree = ok ? ts_parser_parse_string(parser, NULL, source, length) : NULL;
+    ts_parser_set_included_ranges(parser, NULL, 0);
+    free(scan.ranges);
+    if (!tree) {
+        return false;
+    }
+
+    TSNode root = ts_tree_root_node(tree);
+    uint32_t count = ts_node_named_child_count(root);
+    TSNode *directives = malloc((count ? count : 1) * sizeof(TSNode));
+    if (!directives) {
+        ts_tree_delete(tree);
+        return false;
+    }
+
+    const TSLanguage *language = ts_parser_language(parser);
+    TSSymbol directive_symbols[LENGTH_OF(DIRECTIVE_NODES)];
+    for (size_t i = 0; i < LENGTH_OF(DIRECTIVE_NODES); i++) {
+        const char *name = DIRECTIVE_NODES[i];
+        directive_symbols[i] = ts_language_symbol_for_name(language, name, (uint32_t)strlen(name), true);
+    }
+
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    for (bool more = ts_tree_cursor_goto_first_child(&cursor); more; more = ts_tree_cursor_goto_next_sibling(&cursor)) {
+        TSNode node = ts_tree_cursor_current_node(&cursor);
+        if (is_directive(ts_node_symbol(node), directive_symbols)) {
+            directives[summary->directive_count++] = node;
+        }
+    }
+    ts_tree_cursor_delete(&cursor);
+
+    summary->tree = tree;
+    summary->directives = directives;
+    return true;
+}
+
+void tree_sitter_razor_summary_delete(TSRazorSummary *summary) {
+    if (summary->tree) {
+        ts_tree_delete(summary->tree);
+    }
+    free(summary->directives);
+    memset(summary, 0, sizeof(*summary));
+}
@@ -0,0 +1,39 @@
+#ifndef TREE_SITTER_RAZOR_BATCH_H_
+#define TREE_SITTER_RAZOR_BATCH_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct TSTree TSTree;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A UTF-8 document to parse. The contents must stay valid until the batch
+// returns; the resulting tree does not reference them afterwards.
+typedef struct {
+    const char *contents;
+    uint32_t length;
+} TSRazorBatchInput;
+
+// Parse `count` documents on up to `thread_count` threads, 0 meaning one per
+// online CPU. The calling thread takes part, and each thread owns one
+// TSParser that it reuses for every document it picks up. Threads take the
+// next unparsed document as they finish, so a few large files do not hold up
+// the rest of the batch.
+//
+// On return `trees[i]` holds the tree for `inputs[i]`, or NULL if that
+// document could not be parsed. The caller owns the trees and releases them
+// with `ts_tree_delete`. Returns false without parsing anything if the
+// language is incompatible with the linked tree-sitter library.
+//
+// Requires linking against libtree-sitter and libtree-sitter-razor-batch.
+bool tree_sitter_razor_parse_batch(const TSRazorBatchInput *inputs, uint32_t count, uint32_t thread_count,
+                                   TSTree **trees);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_RAZOR_BATCH_H_
@@ -0,0 +1,109 @@
+#ifndef TREE_SITTER_RAZOR_CACHE_H_
+#define TREE_SITTER_RAZOR_CACHE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct TSLanguage TSLanguage;
+typedef struct TSTree TSTree;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A parse tree saved so that it can be mapped and walked in a later run
+// without parsing the document again.
+//
+// The format is a TSRazorCacheHeader followed by one TSRazorCacheNode per
+// visible node in pre-order, the root first. Everything is in host byte
+// order (little-endian on every supported platform); a cache written on a
+// host of the other byte order fails the magic check and is parsed again.
+// Symbol and field IDs are the ones the grammar's ts_language_symbol_name
+// and ts_language_field_name_for_id take, which src/node-types.json names.
+
+#define TS_RAZOR_CACHE_MAGIC 0x5A525354u  // "TSRZ"
+#define TS_RAZOR_CACHE_FORMAT 1
+#define TS_RAZOR_CACHE_NONE UINT32_MAX    // No such node
+
+typedef struct {
+    uint32_t magic;
+    uint16_t format;
+    uint16_t abi_version;        // LANGUAGE_VERSION the grammar was generated with
+    uint8_t grammar_version[4];  // Major, minor and patch from tree-sitter.json, then 0
+    uint32_t symbol_count;
+    uint32_t field_count;
+    uint32_t node_count;
+    uint64_t grammar_hash;       // Hash of every symbol and field name, in ID order
+    uint64_t content_hash;       // tree_sitter_razor_cache_hash of the document
+    uint32_t content_length;
+    uint32_t reserved;
+} TSRazorCacheHeader;
+
+enum {
+    TSRazorCacheNamed = 1 << 0,
+    TSRazorCacheExtra = 1 << 1,
+    TSRazorCacheMissing = 1 << 2,
+    TSRazorCacheHasError = 1 << 3,
+};
+
+typedef struct {
+    uint16_t symbol;            // ts_node_symbol; ERROR is 65535
+    uint16_t field;             // Field of the node in its parent, 0 if none
+    uint16_t flags;             // TSRazorCache* flags
+    uint16_t reserved;
+    uint32_t start_byte;
+    uint32_t end_byte;
+    uint32_t start_row;
+    uint32_t start_column;
+    uint32_t end_row;
+    uint32_t end_column;
+    uint32_t parent;            // Index of the parent, TS_RAZOR_CACHE_NONE for the root
+    uint32_t descendant_count;  // Nodes in the subtree, this one included
+} TSRazorCacheNode;
+
+// A validated cache. Both pointers point into the caller's buffer.
+typedef struct {
+    const TSRazorCacheHeader *header;
+    const TSRazorCacheNode *nodes;
+} TSRazorCache;
+
+// 64-bit FNV-1a hash of a document, the key caches are checked against.
+uint64_t tree_sitter_razor_cache_hash(const char *source, uint32_t length);
+
+// Encode `tree`, parsed from `source`, into a buffer allocated with malloc.
+// Sets `*size` to its length in bytes. Returns NULL if memory runs out.
+void *tree_sitter_razor_cache_encode(const TSTree *tree, const char *source, uint32_t length, size_t *size);
+
+// Check `size` bytes at `data`, such as a mapped cache file, and fill in
+// `cache`. The data must be 8-byte aligned, which a mapping always is.
+// Fails if the data is not a cache, is truncated, or was written by a
+// different version of the format or of `language`. If `source` is not
+// NULL it also fails unless the cache was written for exactly that
+// document; callers that key their cache files by content hash already
+// can pass NULL.
+//
+// Requires linking against libtree-sitter and libtree-sitter-razor-batch.
+bool tree_sitter_razor_cache_open(const void *data, size_t size, const TSLanguage *language, const char *source,
+                                  uint32_t length, TSRazorCache *cache);
+
+// Navigation. Node 0 is the root; a node's children follow it in order.
+
+static inline uint32_t tree_sitter_razor_cache_first_child(const TSRazorCache *cache, uint32_t index) {
+    return cache->nodes[index].descendant_count > 1 ? index + 1 : TS_RAZOR_CACHE_NONE;
+}
+
+static inline uint32_t tree_sitter_razor_cache_next_sibling(const TSRazorCache *cache, uint32_t index) {
+    uint32_t parent = cache->nodes[index].parent;
+    uint32_t next = index + cache->nodes[index].descendant_count;
+    if (parent == TS_RAZOR_CACHE_NONE || next >= parent + cache->nodes[parent].descendant_count) {
+        return TS_RAZOR_CACHE_NONE;
+    }
+    return next;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_RAZOR_CACHE_H_
@@ -0,0 +1,54 @@
+#ifndef TREE_SITTER_RAZOR_FILE_H_
+#define TREE_SITTER_RAZOR_FILE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct TSParser TSParser;
+typedef struct TSTree TSTree;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Encodings a document can be mapped in, detected from its byte order mark.
+// Files without one are read as UTF-8.
+typedef enum {
+    TSRazorFileUTF8,
+    TSRazorFileUTF16LE,
+    TSRazorFileUTF16BE,
+} TSRazorFileEncoding;
+
+// A read-only memory mapping of a document. `contents` points just past the
+// byte order mark, if any, and `length` counts bytes from there; the byte
+// ranges of trees parsed from the file are relative to `contents`, so node
+// text is `contents + ts_node_start_byte(node)` with no copy.
+typedef struct {
+    const char *contents;
+    uint32_t length;
+    TSRazorFileEncoding encoding;
+    void *mapping;          // Private: base of the mapping, NULL when empty
+    size_t mapping_length;  // Private
+} TSRazorMappedFile;
+
+// Map the file at `path`. Returns false and sets errno if it cannot be opened
+// or mapped, or if it is larger than 4GB (EFBIG).
+bool tree_sitter_razor_file_map(const char *path, TSRazorMappedFile *file);
+
+// Release a mapping. Trees parsed from the file stay valid, but node text
+// can no longer be read from it.
+void tree_sitter_razor_file_unmap(TSRazorMappedFile *file);
+
+// Parse a mapped file, decoding UTF-16 if that is what the file holds.
+// `parser` must already have the Razor language set. The input is handed to
+// the parser straight from the mapping rather than copied.
+//
+// Requires linking against libtree-sitter and libtree-sitter-razor-batch.
+TSTree *tree_sitter_razor_file_parse(TSParser *parser, const TSTree *old_tree, const TSRazorMappedFile *file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_RAZOR_FILE_H_
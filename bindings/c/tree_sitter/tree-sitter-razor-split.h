@@ -0,0 +1,18 @@
+#ifndef TREE_SITTER_RAZOR_SPLIT_H_
+#define TREE_SITTER_RAZOR_SPLIT_H_
+
+typedef struct TSLanguage TSLanguage;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The split grammar (split/grammar.js): Razor markup with every C# region as
+// an opaque csharp_code node, to be parsed through an injection.
+const TSLanguage *tree_sitter_razor_split(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_RAZOR_SPLIT_H_
@@ -0,0 +1,46 @@
+#ifndef TREE_SITTER_RAZOR_STATS_H_
+#define TREE_SITTER_RAZOR_STATS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// External scanner counters for one entry. Entries are the grammar's
+// external tokens in declaration order, followed by one that stands for the
+// embedded C# scanner as a whole.
+typedef struct {
+    uint64_t calls;              // Scan calls in which the token was valid
+    uint64_t successes;          // Calls that returned the token
+    uint64_t advanced;           // Characters advanced over by those calls, skipped ones included
+    uint64_t rejections;         // Calls that returned nothing after last trying this token
+    uint64_t rejected_advanced;  // Characters advanced over by those calls, then thrown away
+} TSRazorTokenStats;
+
+// Only available when libtree-sitter-razor is built with
+// TREE_SITTER_RAZOR_STATS defined (the TREE_SITTER_RAZOR_STATS CMake
+// option). Counting puts a wrapper between the parser's lexer and the
+// scanner; builds without it are unaffected.
+//
+// The counters are process-wide and accumulate across every parser and
+// thread until reset.
+
+// Number of entries, external tokens plus the C# scanner entry
+unsigned tree_sitter_razor_stats_token_count(void);
+
+// Name of an entry, e.g. "RAZOR_BLOCK_OPEN" or "(c_sharp scanner)", or NULL
+// if `token` is out of range
+const char *tree_sitter_razor_stats_token_name(unsigned token);
+
+// Copy the counters for one entry. Returns false if `token` is out of range.
+bool tree_sitter_razor_stats_read(unsigned token, TSRazorTokenStats *stats);
+
+void tree_sitter_razor_stats_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_RAZOR_STATS_H_
@@ -0,0 +1,57 @@
+#ifndef TREE_SITTER_RAZOR_STREAM_H_
+#define TREE_SITTER_RAZOR_STREAM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <tree_sitter/api.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A UTF-8 document read front to back. `read` copies up to `length` bytes
+// into `buffer` and returns how many it copied, 0 once the document has
+// ended. It is never asked for the same bytes twice.
+typedef struct {
+    void *payload;
+    uint32_t (*read)(void *payload, char *buffer, uint32_t length);
+} TSRazorStreamInput;
+
+// Receives one top-level node of the document: an element, a Razor
+// statement, a code block, a run of text and so on, or an ERROR. `text` is
+// the node's source, ts_node_end_byte(node) - ts_node_start_byte(node) bytes
+// long; the text of a descendant starts at its own start byte minus the
+// node's. Byte offsets and points are relative to the whole document.
+//
+// The node, its tree and `text` are only valid during the call. Return false
+// to stop the stream.
+typedef bool (*TSRazorStreamCallback)(void *payload, TSNode node, const char *text);
+
+// Parse a document in windows of about `window_size` bytes, 0 meaning 1MB,
+// and hand its top-level nodes to `callback` in document order. Each window
+// is parsed as a tree of its own and deleted once its nodes have been
+// handed out, so memory stays proportional to the window rather than to
+// the document.
+//
+// The last two top-level nodes of a window are held back and parsed again
+// at the start of the next one: the last may be cut off, and the one before
+// may still be continued by what follows, such as an @if that an `else`
+// after the window edge belongs to. A window that holds no more than that
+// is doubled until it does, so a single node larger than the window costs
+// memory in proportion to that node.
+//
+// `parser` must already have the Razor language set. Its included ranges
+// are used to place each window in the document and are reset on return.
+// Returns false if a window could not be parsed, memory ran out or the
+// document is larger than 4GB; the nodes handed out up to then stand.
+//
+// Requires linking against libtree-sitter and libtree-sitter-razor-batch.
+bool tree_sitter_razor_parse_stream(TSParser *parser, TSRazorStreamInput input, uint32_t window_size,
+                                    TSRazorStreamCallback callback, void *payload);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_RAZOR_STREAM_H_
@@ -0,0 +1,65 @@
+#ifndef TREE_SITTER_RAZOR_SUMMARY_H_
+#define TREE_SITTER_RAZOR_SUMMARY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <tree_sitter/api.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// How much of a document to look through for directives.
+typedef enum {
+    // Only the leading block of directives, comments, whitespace and code
+    // blocks (`@{ ... }`) that Razor files start with. The search ends at
+    // the first markup, which is where @page, @using, @inject and the like
+    // normally stop.
+    TSRazorSummaryLeading,
+    // The whole document. Code blocks, @code and @functions bodies,
+    // sections and statements are still skipped without being parsed.
+    TSRazorSummaryDocument,
+} TSRazorSummaryScope;
+
+// The single-line directives of a document (@page, @model, @using,
+// @inject, @inherits, @namespace, @layout, @attribute, @implements,
+// @typeparam, @preservewhitespace, @rendermode and the tag helper
+// directives) as razor_*_directive nodes, in document order. Their byte
+// offsets and points are relative to the whole document, and their
+// children are parsed as usual, so the route of a @page is its
+// string_literal child and an @inject has its type and identifier.
+//
+// @code, @functions and @section are not included: their bodies are the
+// part of the document being skipped.
+typedef struct {
+    TSTree *tree;  // Parsed from the directive lines only; NULL if there were none
+    TSNode *directives;
+    uint32_t directive_count;
+} TSRazorSummary;
+
+// Find the directives of a UTF-8 document without parsing the rest of it.
+//
+// A quick pass over the source finds the lines that hold directives,
+// skipping Razor and HTML comments and matching the braces of code blocks
+// and statements the way C# counts them, past strings, character literals
+// and comments. Only those lines are then handed to the parser, as included
+// ranges, so the cost of the parse does not grow with the markup and code
+// around them.
+//
+// `parser` must already have the Razor language set. Its included ranges
+// are reset on return. Returns false if memory runs out or the parse
+// fails, leaving `summary` empty; otherwise the caller releases it with
+// tree_sitter_razor_summary_delete.
+//
+// Requires linking against libtree-sitter and libtree-sitter-razor-batch.
+bool tree_sitter_razor_summarize(TSParser *parser, const char *source, uint32_t length, TSRazorSummaryScope scope,
+                                 TSRazorSummary *summary);
+
+void tree_sitter_razor_summary_delete(TSRazorSummary *summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TREE_SITTER_RAZOR_SUMMARY_H_
@@ -1,4 +1,7 @@
 const assert = require("node:assert");
+const fs = require("node:fs");
+const os = require("node:os");
+const path = require("node:path");
 const { test } = require("node:test");
 
 const Parser = require("tree-sitter");
@@ -7,3 +10,46 @@ test("can load grammar", () => {
   const parser = new Parser();
   assert.doesNotThrow(() => parser.setLanguage(require(".")));
 });
+
+test("summarizes a document off the main thread", async (t) => {
+  const binding = require(".");
+  if (!binding.parseAsync) {
+    return t.skip("built without the tree-sitter runtime");
+  }
+  const summary = await binding.parseAsync(
+    Buffer.from("@page \"/counter\"\n@inject ILogger<Index> Logger\n\n<Counter Start=\"1\" />\n"),
+  );
+  assert.strictEqual(summary.hasError, false);
+  assert.deepStrictEqual(
+    summary.directives.map((directive) => directive.type),
+    ["razor_page_directive", "razor_inject_directive"],
+  );
+  assert.strictEqual(summary.directives[0].text, '@page "/counter"');
+  assert.deepStrictEqual(summary.injects, [{ type: "ILogger<Index>", name: "Logger" }]);
+  assert.deepStrictEqual(
+    summary.components.map((component) => [component.name, component.startPosition.row]),
+    [["Counter", 3]],
+  );
+});
+
+test("summarizes files in bulk", async (t) => {
+  const binding = require(".");
+  if (!binding.parseFiles) {
+    return t.skip("built without the tree-sitter runtime");
+  }
+  const directory = fs.mkdtempSync(path.join(os.tmpdir(), "tree-sitter-razor-"));
+  t.after(() => fs.rmSync(directory, { recursive: true }));
+
+  const page = path.join(directory, "Index.razor");
+  fs.writeFileSync(page, "@layout MainLayout\n<EditForm Model=\"@model\"></EditForm>\n");
+  const utf16 = path.join(directory, "Legacy.cshtml");
+  fs.writeFileSync(utf16, Buffer.concat([Buffer.from([0xff, 0xfe]), Buffer.from("@model Foo\n", "utf16le")]));
+  const missing = path.join(directory, "Missing.razor");
+
+  const [first, second, third] = await binding.parseFiles([page, utf16, missing], { threads: 2 });
+  assert.deepStrictEqual(first.directives.map((directive) => directive.text), ["@layout MainLayout"]);
+  assert.deepStrictEqual(first.components.map((component) => component.name), ["EditForm"]);
+  assert.deepStrictEqual(second.directives.map((directive) => directive.text), ["@model Foo"]);
+  assert.strictEqual(third.path, missing);
+  assert.ok(third.error);
+});
@@ -18,9 +18,68 @@ type NodeInfo =
       children: ChildNode[];
     });
 
+type Point = {
+  row: number;
+  column: number;
+};
+
+/** Byte offsets are into the document as UTF-8, after any byte order mark. */
+type Range = {
+  startByte: number;
+  endByte: number;
+  startPosition: Point;
+  endPosition: Point;
+};
+
+type Directive = Range & {
+  /** The node type, such as `razor_page_directive`. */
+  type: string;
+  text: string;
+};
+
+/** A `component_element` or `self_closing_component`. */
+type ComponentReference = Range & {
+  name: string;
+};
+
+type Inject = {
+  type: string;
+  name: string;
+};
+
+/** What a document declares and uses, from a parse on a worker thread. */
+type Summary = {
+  hasError: boolean;
+  directives: Directive[];
+  components: ComponentReference[];
+  injects: Inject[];
+};
+
+type FileSummary =
+  | (Summary & { path: string; error?: undefined })
+  | { path: string; error: string };
+
 type Language = {
   language: unknown;
   nodeTypeInfo: NodeInfo[];
+  /**
+   * Parses `source` on the libuv thread pool with a parser kept from earlier
+   * calls, and summarizes it there. The source is copied first, so the
+   * buffer may be reused at once.
+   *
+   * Only present when the addon was built with the `tree-sitter` package
+   * installed, whose vendored runtime it compiles in.
+   */
+  parseAsync?(source: Buffer | string): Promise<Summary>;
+  /**
+   * Reads, parses and summarizes every file on `threads` native threads
+   * (one per CPU by default), each reusing a pooled parser. Files that
+   * cannot be read come back with an `error` instead of a summary. Files
+   * with a UTF-16 byte order mark are converted to UTF-8 first.
+   *
+   * Only present when `parseAsync` is.
+   */
+  parseFiles?(paths: string[], options?: { threads?: number }): Promise<FileSummary[]>;
 };
 
 declare const language: Language;
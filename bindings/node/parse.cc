@@ -0,0 +1,463 @@
+// Parsing off the main thread, with the results summarized natively
+//
+// The addon carries its own copy of the tree-sitter runtime, so its trees
+// cannot be handed to the `tree-sitter` package's Tree class. Instead each
+// document is parsed and summarized on a worker thread, and JavaScript gets
+// back one small object per document: its directives, the components it
+// uses and what it injects. Nothing crosses into JavaScript per node.
+
+#include <napi.h>
+
+#include <tree_sitter/api.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+extern "C" TSLanguage *tree_sitter_razor();
+
+namespace {
+
+// Parsers are expensive to set up and cheap to reset, so they are kept
+// between calls and shared by every worker thread
+class ParserPool {
+  public:
+    ~ParserPool() {
+        for (TSParser *parser : idle_) {
+            ts_parser_delete(parser);
+        }
+    }
+
+    // Returns NULL if the language does not fit the bundled runtime
+    TSParser *Acquire() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!idle_.empty()) {
+                TSParser *parser = idle_.back();
+                idle_.pop_back();
+                return parser;
+            }
+        }
+        TSParser *parser = ts_parser_new();
+        if (!ts_parser_set_language(parser, tree_sitter_razor())) {
+            ts_parser_delete(parser);
+            return nullptr;
+        }
+        return parser;
+    }
+
+    void Release(TSParser *parser) {
+        ts_parser_reset(parser);
+        std::lock_guard<std::mutex> lock(mutex_);
+        idle_.push_back(parser);
+    }
+
+  private:
+    std::mutex mutex_;
+    std::vector<TSParser *> idle_;
+};
+
+ParserPool parser_pool;
+
+// The symbols a summary looks for, looked up once
+struct SummarySymbols {
+    std::vector<bool> directive;  // Indexed by symbol: every razor_*_directive
+    TSSymbol inject_directive;
+    TSSymbol component_element;
+    TSSymbol self_closing_component;
+};
+
+const SummarySymbols &summary_symbols() {
+    static SummarySymbols symbols;
+    static std::once_flag once;
+    std::call_once(once, [] {
+        const TSLanguage *language = tree_sitter_razor();
+        uint32_t count = ts_language_symbol_count(language);
+        symbols.directive.resize(count);
+        for (uint32_t symbol = 0; symbol < count; symbol++) {
+            const char *name = ts_language_symbol_name(language, (TSSymbol)symbol);
+            size_t length = name ? strlen(name) : 0;
+            symbols.directive[symbol] = ts_language_symbol_type(language, (TSSymbol)symbol) == TSSymbolTypeRegular &&
+                                        length > 16 && strncmp(name, "razor_", 6) == 0 &&
+                                        strcmp(name + length - 10, "_directive") == 0;
+        }
+        // A name the parser does not have looks up as 0, the end symbol,
+        // which no node in a tree has: a parser.c generated before the
+        // component rules gives summaries without components, never wrong
+        // ones
+        auto lookup = [language](const char *name) {
+            return ts_language_symbol_for_name(language, name, (uint32_t)strlen(name), true);
+        };
+        symbols.inject_directive = lookup("razor_inject_directive");
+        symbols.component_element = lookup("component_element");
+        symbols.self_closing_component = lookup("self_closing_component");
+    });
+    return symbols;
+}
+
+struct Range {
+    uint32_t start_byte;
+    uint32_t end_byte;
+    TSPoint start_point;
+    TSPoint end_point;
+};
+
+Range node_range(TSNode node) {
+    return {ts_node_start_byte(node), ts_node_end_byte(node), ts_node_start_point(node), ts_node_end_point(node)};
+}
+
+struct Directive {
+    const char *type;  // Owned by the language
+    Range range;
+};
+
+struct Component {
+    Range name;
+    Range range;
+};
+
+struct Inject {
+    Range type;
+    Range name;
+};
+
+struct Summary {
+    bool has_error = false;
+    std::vector<Directive> directives;
+    std::vector<Component> components;
+    std::vector<Inject> injects;
+};
+
+void summarize_node(TSNode node, Summary &summary) {
+    const SummarySymbols &symbols = summary_symbols();
+    TSSymbol symbol = ts_node_symbol(node);
+
+    if (symbol < symbols.directive.size() && symbols.directive[symbol]) {
+        summary.directives.push_back({ts_node_type(node), node_range(node)});
+        uint32_t count = ts_node_named_child_count(node);
+        if (symbol == symbols.inject_directive && count >= 2) {
+            summary.injects.push_back(
+                {node_range(ts_node_named_child(node, 0)), node_range(ts_node_named_child(node, count - 1))});
+        }
+    } else if (symbol == symbols.self_closing_component || symbol == symbols.component_element) {
+        TSNode tag = symbol == symbols.component_element ? ts_node_child(node, 0) : node;
+        TSNode name = ts_node_child_by_field_name(tag, "name", 4);
+        if (!ts_node_is_null(name)) {
+            summary.components.push_back({node_range(name), node_range(node)});
+        }
+    }
+}
+
+// Pre-order walk of the whole tree. Directives can appear inside elements
+// and components inside C# blocks, so no subtree can be skipped.
+void summarize(const TSTree *tree, Summary &summary) {
+    TSNode root = ts_tree_root_node(tree);
+    summary.has_error = ts_node_has_error(root);
+
+    TSTreeCursor cursor = ts_tree_cursor_new(root);
+    for (;;) {
+        summarize_node(ts_tree_cursor_current_node(&cursor), summary);
+        if (ts_tree_cursor_goto_first_child(&cursor)) {
+            continue;
+        }
+        while (!ts_tree_cursor_goto_next_sibling(&cursor)) {
+            if (!ts_tree_cursor_goto_parent(&cursor)) {
+                ts_tree_cursor_delete(&cursor);
+                return;
+            }
+        }
+    }
+}
+
+void append_utf8(std::string &out, uint32_t c) {
+    if (c < 0x80) {
+        out += (char)c;
+    } else if (c < 0x800) {
+        out += (char)(0xC0 | (c >> 6));
+        out += (char)(0x80 | (c & 0x3F));
+    } else if (c < 0x10000) {
+        out += (char)(0xE0 | (c >> 12));
+        out += (char)(0x80 | ((c >> 6) & 0x3F));
+        out += (char)(0x80 | (c & 0x3F));
+    } else {
+        out += (char)(0xF0 | (c >> 18));
+        out += (char)(0x80 | ((c >> 12) & 0x3F));
+        out += (char)(0x80 | ((c >> 6) & 0x3F));
+        out += (char)(0x80 | (c & 0x3F));
+    }
+}
+
+// Files are read as UTF-8 unless they start with a UTF-16 byte order mark,
+// as Visual Studio writes them, in which case they are converted so that
+// every range is a UTF-8 byte offset. Unpaired surrogates become U+FFFD.
+std::string decode(std::string bytes) {
+    auto starts_with = [&bytes](const char *mark, size_t length) {
+        return bytes.size() >= length && memcmp(bytes.data(), mark, length) == 0;
+    };
+    if (starts_with("\xEF\xBB\xBF", 3)) {
+        return bytes.substr(3);
+    }
+    bool little = starts_with("\xFF\xFE", 2);
+    if (!little && !starts_with("\xFE\xFF", 2)) {
+        return bytes;
+    }
+
+    std::string text;
+    text.reserve(bytes.size());
+    auto unit = [&bytes, little](size_t i) -> uint32_t {
+        auto lo = (unsigned char)bytes[i + (little ? 0 : 1)], hi = (unsigned char)bytes[i + (little ? 1 : 0)];
+        return lo | (hi << 8);
+    };
+    for (size_t i = 2; i + 1 < bytes.size(); i += 2) {
+        uint32_t c = unit(i);
+        if (c >= 0xD800 && c < 0xDC00 && i + 3 < bytes.size() && unit(i + 2) >= 0xDC00 && unit(i + 2) < 0xE000) {
+            c = 0x10000 + ((c - 0xD800) << 10) + (unit(i + 2) - 0xDC00);
+            i += 2;
+        } else if (c >= 0xD800 && c < 0xE000) {
+            c = 0xFFFD;
+        }
+        append_utf8(text, c);
+    }
+    return text;
+}
+
+bool read_file(const std::string &path, std::string &contents, std::string &error) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) {
+        error = std::generic_category().message(errno);
+        return false;
+    }
+    char chunk[1 << 16];
+    size_t length;
+    while ((length = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        contents.append(chunk, length);
+    }
+    bool failed = ferror(file);
+    fclose(file);
+    if (failed) {
+        error = "read failed";
+        return false;
+    }
+    if (contents.size() > UINT32_MAX) {
+        error = "file is larger than 4GB";
+        return false;
+    }
+    contents = decode(std::move(contents));
+    return true;
+}
+
+struct Document {
+    std::string path;
+    std::string source;
+    std::string error;
+    Summary summary;
+};
+
+// Parses and summarizes its documents on `thread_count` threads of its own,
+// the libuv thread it runs on included, then settles a promise with the
+// summaries: an array for parseFiles, a single one for parseAsync
+class ParseWorker : public Napi::AsyncWorker {
+  public:
+    ParseWorker(Napi::Env env, std::vector<Document> documents, uint32_t thread_count, bool single)
+        : Napi::AsyncWorker(env), deferred_(Napi::Promise::Deferred::New(env)), documents_(std::move(documents)),
+          thread_count_(std::max<uint32_t>(1, std::min<uint32_t>(thread_count, (uint32_t)documents_.size()))),
+          single_(single) {}
+
+    Napi::Promise Promise() { return deferred_.Promise(); }
+
+  protected:
+    void Execute() override {
+        std::atomic<size_t> next(0);
+        std::atomic<bool> incompatible(false);
+        auto work = [this, &next, &incompatible] {
+            TSParser *parser = parser_pool.Acquire();
+            if (!parser) {
+                incompatible = true;
+                return;
+            }
+            for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < documents_.size();) {
+                Document &document = documents_[i];
+                if (!document.path.empty() && !read_file(document.path, document.source, document.error)) {
+                    continue;
+                }
+                TSTree *tree = ts_parser_parse_string(parser, nullptr, document.source.data(),
+                                                      (uint32_t)document.source.size());
+                if (!tree) {
+                    document.error = "parse failed";
+                    continue;
+                }
+                summarize(tree, document.summary);
+                ts_tree_delete(tree);
+            }
+            parser_pool.Release(parser);
+        };
+
+        std::vector<std::thread> threads;
+        for (uint32_t i = 1; i < thread_count_; i++) {
+            threads.emplace_back(work);
+        }
+        work();
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        if (incompatible) {
+            SetError("the Razor language is incompatible with the bundled tree-sitter runtime");
+        }
+    }
+
+    void OnOK() override {
+        Napi::Env env = Env();
+        if (single_) {
+            deferred_.Resolve(SummaryObject(env, documents_[0]));
+            return;
+        }
+        Napi::Array results = Napi::Array::New(env, documents_.size());
+        for (uint32_t i = 0; i < documents_.size(); i++) {
+            results[i] = SummaryObject(env, documents_[i]);
+        }
+        deferred_.Resolve(results);
+    }
+
+    void OnError(const Napi::Error &error) override { deferred_.Reject(error.Value()); }
+
+  private:
+    static Napi::Object PointObject(Napi::Env env, TSPoint point) {
+        Napi::Object object = Napi::Object::New(env);
+        object["row"] = point.row;
+        object["column"] = point.column;
+        return object;
+    }
+
+    static void SetRange(Napi::Env env, Napi::Object object, const Range &range) {
+        object["startByte"] = range.start_byte;
+        object["endByte"] = range.end_byte;
+        object["startPosition"] = PointObject(env, range.start_point);
+        object["endPosition"] = PointObject(env, range.end_point);
+    }
+
+    static Napi::String Text(Napi::Env env, const Document &document, const Range &range) {
+        return Napi::String::New(env, document.source.data() + range.start_byte, range.end_byte - range.start_byte);
+    }
+
+    static Napi::Object SummaryObject(Napi::Env env, const Document &document) {
+        Napi::Object result = Napi::Object::New(env);
+        if (!document.path.empty()) {
+            result["path"] = document.path;
+        }
+        if (!document.error.empty()) {
+            result["error"] = document.error;
+            return result;
+        }
+        const Summary &summary = document.summary;
+        result["hasError"] = summary.has_error;
+
+        Napi::Array directives = Napi::Array::New(env, summary.directives.size());
+        for (uint32_t i = 0; i < summary.directives.size(); i++) {
+            const Directive &directive = summary.directives[i];
+            Napi::Object object = Napi::Object::New(env);
+            object["type"] = directive.type;
+            object["text"] = Text(env, document, directive.range);
+            SetRange(env, object, directive.range);
+            directives[i] = object;
+        }
+        result["directives"] = directives;
+
+        Napi::Array components = Napi::Array::New(env, summary.components.size());
+        for (uint32_t i = 0; i < summary.components.size(); i++) {
+            const Component &component = summary.components[i];
+            Napi::Object object = Napi::Object::New(env);
+            object["name"] = Text(env, document, component.name);
+            SetRange(env, object, component.range);
+            components[i] = object;
+        }
+        result["components"] = components;
+
+        Napi::Array injects = Napi::Array::New(env, summary.injects.size());
+        for (uint32_t i = 0; i < summary.injects.size(); i++) {
+            Napi::Object object = Napi::Object::New(env);
+            object["type"] = Text(env, document, summary.injects[i].type);
+            object["name"] = Text(env, document, summary.injects[i].name);
+            injects[i] = object;
+        }
+        result["injects"] = injects;
+        return result;
+    }
+
+    Napi::Promise::Deferred deferred_;
+    std::vector<Document> documents_;
+    uint32_t thread_count_;
+    bool single_;
+};
+
+uint32_t thread_option(const Napi::CallbackInfo &info, size_t index) {
+    uint32_t threads = std::thread::hardware_concurrency();
+    if (info.Length() > index && info[index].IsObject()) {
+        Napi::Value value = info[index].As<Napi::Object>().Get("threads");
+        if (value.IsNumber() && value.As<Napi::Number>().Uint32Value() > 0) {
+            threads = value.As<Napi::Number>().Uint32Value();
+        }
+    }
+    return threads ? threads : 1;
+}
+
+// parseAsync(source: Buffer | string): Promise<Summary>
+Napi::Value ParseAsync(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    Document document;
+    if (info.Length() > 0 && info[0].IsBuffer()) {
+        Napi::Buffer<char> buffer = info[0].As<Napi::Buffer<char>>();
+        document.source = decode(std::string(buffer.Data(), buffer.Length()));
+    } else if (info.Length() > 0 && info[0].IsString()) {
+        document.source = info[0].As<Napi::String>().Utf8Value();
+    } else {
+        throw Napi::TypeError::New(env, "source must be a Buffer or a string");
+    }
+
+    // The copy is what the worker thread reads, so the caller may reuse the
+    // buffer at once
+    std::vector<Document> documents;
+    documents.push_back(std::move(document));
+    auto *worker = new ParseWorker(env, std::move(documents), 1, true);
+    worker->Queue();
+    return worker->Promise();
+}
+
+// parseFiles(paths: string[], options?: {threads?: number}): Promise<Summary[]>
+Napi::Value ParseFiles(const Napi::CallbackInfo &info) {
+    Napi::Env env = info.Env();
+    if (info.Length() == 0 || !info[0].IsArray()) {
+        throw Napi::TypeError::New(env, "paths must be an array of strings");
+    }
+    Napi::Array paths = info[0].As<Napi::Array>();
+    std::vector<Document> documents(paths.Length());
+    for (uint32_t i = 0; i < paths.Length(); i++) {
+        Napi::Value path = paths[i];
+        if (!path.IsString() || path.As<Napi::String>().Utf8Value().empty()) {
+            throw Napi::TypeError::New(env, "paths must be an array of strings");
+        }
+        documents[i].path = path.As<Napi::String>().Utf8Value();
+    }
+
+    if (documents.empty()) {
+        Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+        deferred.Resolve(Napi::Array::New(env));
+        return deferred.Promise();
+    }
+    auto *worker = new ParseWorker(env, std::move(documents), thread_option(info, 1), false);
+    worker->Queue();
+    return worker->Promise();
+}
+
+} // namespace
+
+void InitParse(Napi::Env env, Napi::Object exports) {
+    exports["parseAsync"] = Napi::Function::New(env, ParseAsync, "parseAsync");
+    exports["parseFiles"] = Napi::Function::New(env, ParseFiles, "parseFiles");
+}
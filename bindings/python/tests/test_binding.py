@@ -1,6 +1,6 @@
 from unittest import TestCase
 
-from tree_sitter import Language, Parser
+from tree_sitter import Language, Parser, Query
 import tree_sitter_razor
 
 
@@ -10,3 +10,46 @@ class TestLanguage(TestCase):
             Parser(Language(tree_sitter_razor.language()))
         except Exception:
             self.fail("Error loading Razor grammar")
+
+    def test_queries_compile(self):
+        language = Language(tree_sitter_razor.language())
+        for name in ("HIGHLIGHTS_QUERY", "INJECTIONS_QUERY", "LOCALS_QUERY", "TAGS_QUERY"):
+            with self.subTest(name):
+                Query(language, getattr(tree_sitter_razor, name))
+
+    def test_parse_batch(self):
+        sources = [f"<p>Item {i}</p>" for i in range(32)]
+        trees = tree_sitter_razor.parse_batch(sources, threads=4)
+        self.assertEqual(len(trees), len(sources))
+        for source, tree in zip(sources, trees):
+            self.assertFalse(tree.root_node.has_error)
+            self.assertEqual(tree.root_node.end_byte, len(source))
+
+    def test_cache_round_trip(self):
+        source = b"@page \"/\"\n<ul>@foreach (var item in Items) { <li>@item</li> }</ul>\n"
+        language = Language(tree_sitter_razor.language())
+        tree = Parser(language).parse(source)
+
+        data = tree_sitter_razor.encode_cache(tree, source)
+        cache = tree_sitter_razor.CachedTree(data, language, source)
+        with self.assertRaises(ValueError):
+            tree_sitter_razor.CachedTree(data, language, b"<p></p>")
+        with self.assertRaises(ValueError):
+            tree_sitter_razor.CachedTree(data[:-1], language)
+
+        # Walk both trees in step
+        cursor = tree.walk()
+        index = 0
+        while True:
+            node, cached = cursor.node, cache.node(index)
+            self.assertEqual(cached.kind_id, node.kind_id)
+            self.assertEqual((cached.start_byte, cached.end_byte), (node.start_byte, node.end_byte))
+            self.assertEqual((cached.start_point, cached.end_point), (tuple(node.start_point), tuple(node.end_point)))
+            self.assertEqual(cached.is_named, node.is_named)
+            index += 1
+            if cursor.goto_first_child():
+                continue
+            while not cursor.goto_next_sibling():
+                if not cursor.goto_parent():
+                    self.assertEqual(index, cache.node_count)
+                    return
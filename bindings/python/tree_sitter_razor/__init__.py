@@ -3,6 +3,44 @@
 from importlib.resources import files as _files
 
 from ._binding import language
+from ._cache import CachedNode, CachedTree, content_hash, encode_cache
+
+
+def parse_batch(sources, threads=None):
+    """Parse many documents on a pool of threads.
+
+    This is a convenience over a ``ThreadPoolExecutor``, not a binding of the
+    native ``tree_sitter_razor_parse_batch`` (bindings/c): the extension does
+    not link the tree-sitter runtime, so the parsing goes through
+    ``tree_sitter.Parser``, and threads only overlap while it releases the
+    GIL.
+
+    Each thread owns one ``Parser`` and reuses it for every document it picks
+    up; threads take the next document as they finish. ``sources`` are
+    ``bytes`` or ``str`` (encoded as UTF-8) and ``threads`` defaults to the
+    number of CPUs. Returns the trees in input order.
+
+    Requires the ``core`` extra (the ``tree-sitter`` package).
+    """
+    from concurrent.futures import ThreadPoolExecutor
+    from os import cpu_count
+    from threading import local
+
+    from tree_sitter import Language, Parser
+
+    razor = Language(language())
+    workers = local()
+
+    def parse(source):
+        parser = getattr(workers, "parser", None)
+        if parser is None:
+            parser = workers.parser = Parser(razor)
+        if isinstance(source, str):
+            source = source.encode("utf-8")
+        return parser.parse(source)
+
+    with ThreadPoolExecutor(max_workers=threads or cpu_count() or 1) as pool:
+        return list(pool.map(parse, sources))
 
 
 def _get_query(name, file):
@@ -12,26 +50,29 @@ def _get_query(name, file):
 
 
 def __getattr__(name):
-    # NOTE: uncomment these to include any queries that this grammar contains:
-
-    # if name == "HIGHLIGHTS_QUERY":
-    #     return _get_query("HIGHLIGHTS_QUERY", "highlights.scm")
-    # if name == "INJECTIONS_QUERY":
-    #     return _get_query("INJECTIONS_QUERY", "injections.scm")
-    # if name == "LOCALS_QUERY":
-    #     return _get_query("LOCALS_QUERY", "locals.scm")
-    # if name == "TAGS_QUERY":
-    #     return _get_query("TAGS_QUERY", "tags.scm")
+    if name == "HIGHLIGHTS_QUERY":
+        return _get_query("HIGHLIGHTS_QUERY", "highlights.scm")
+    if name == "INJECTIONS_QUERY":
+        return _get_query("INJECTIONS_QUERY", "injections.scm")
+    if name == "LOCALS_QUERY":
+        return _get_query("LOCALS_QUERY", "locals.scm")
+    if name == "TAGS_QUERY":
+        return _get_query("TAGS_QUERY", "tags.scm")
 
     raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
 
 
 __all__ = [
     "language",
-    # "HIGHLIGHTS_QUERY",
-    # "INJECTIONS_QUERY",
-    # "LOCALS_QUERY",
-    # "TAGS_QUERY",
+    "parse_batch",
+    "content_hash",
+    "encode_cache",
+    "CachedNode",
+    "CachedTree",
+    "HIGHLIGHTS_QUERY",
+    "INJECTIONS_QUERY",
+    "LOCALS_QUERY",
+    "TAGS_QUERY",
 ]
 
 
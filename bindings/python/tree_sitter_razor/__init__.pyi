@@ -1,10 +1,45 @@
-from typing import Final
+from collections.abc import Iterable, Iterator
+from typing import Final, NamedTuple
 
-# NOTE: uncomment these to include any queries that this grammar contains:
+from tree_sitter import Language, Tree
 
-# HIGHLIGHTS_QUERY: Final[str]
-# INJECTIONS_QUERY: Final[str]
-# LOCALS_QUERY: Final[str]
-# TAGS_QUERY: Final[str]
+HIGHLIGHTS_QUERY: Final[str]
+INJECTIONS_QUERY: Final[str]
+LOCALS_QUERY: Final[str]
+TAGS_QUERY: Final[str]
 
 def language() -> object: ...
+
+def parse_batch(sources: Iterable[bytes | str], threads: int | None = None) -> list[Tree]: ...
+
+def content_hash(source: bytes) -> int: ...
+
+def encode_cache(tree: Tree, source: bytes) -> bytes: ...
+
+class CachedNode(NamedTuple):
+    kind_id: int
+    field_id: int
+    flags: int
+    start_byte: int
+    end_byte: int
+    start_point: tuple[int, int]
+    end_point: tuple[int, int]
+    parent: int | None
+    descendant_count: int
+    @property
+    def is_named(self) -> bool: ...
+    @property
+    def is_extra(self) -> bool: ...
+    @property
+    def is_missing(self) -> bool: ...
+    @property
+    def has_error(self) -> bool: ...
+
+class CachedTree:
+    def __init__(self, data: bytes | bytearray | memoryview, language: Language, source: bytes | None = None) -> None: ...
+    @property
+    def node_count(self) -> int: ...
+    def node(self, index: int) -> CachedNode: ...
+    def first_child(self, index: int) -> int | None: ...
+    def next_sibling(self, index: int) -> int | None: ...
+    def children(self, index: int) -> Iterator[int]: ...
@@ -0,0 +1,210 @@
+"""Binary parse tree caches that are walked in place without parsing again.
+
+The format is the one described in ``tree_sitter/tree-sitter-razor-cache.h``,
+little-endian: a 48-byte header followed by one 40-byte record per visible
+node in pre-order, each with the size of its subtree. Caches written here, by
+the Rust crate and by the C library can be read by any of them.
+"""
+
+from struct import Struct
+from typing import NamedTuple
+
+_MAGIC = 0x5A525354  # "TSRZ"
+_FORMAT = 1
+_NONE = 0xFFFFFFFF
+
+_GRAMMAR = Struct("<IHH4BIII Q")
+_CONTENT = Struct("<QII")
+_NODE = Struct("<HHHH8I")
+
+_NAMED = 1 << 0
+_EXTRA = 1 << 1
+_MISSING = 1 << 2
+_HAS_ERROR = 1 << 3
+
+_FNV_OFFSET_BASIS = 0xCBF29CE484222325
+_FNV_PRIME = 0x100000001B3
+_MASK = 0xFFFFFFFFFFFFFFFF
+
+
+def _fnv1a(value, data):
+    for byte in data:
+        value = ((value ^ byte) * _FNV_PRIME) & _MASK
+    return value
+
+
+def content_hash(source):
+    """The 64-bit FNV-1a hash of a document, the key caches are checked against."""
+    return _fnv1a(_FNV_OFFSET_BASIS, source)
+
+
+def _grammar_header(language, node_count):
+    # Every name with its terminating NUL, symbols first, so that any change
+    # to which ID means what changes the hash
+    value = _FNV_OFFSET_BASIS
+    for symbol in range(language.node_kind_count):
+        value = _fnv1a(value, (language.node_kind_for_id(symbol) or "").encode() + b"\0")
+    for field in range(1, language.field_count + 1):
+        value = _fnv1a(value, (language.field_name_for_id(field) or "").encode() + b"\0")
+
+    # semantic_version is None for a parser generated without metadata,
+    # which ts_language_metadata gives as NULL
+    version = language.semantic_version or (0, 0, 0)
+    return _GRAMMAR.pack(
+        _MAGIC, _FORMAT, language.abi_version, *version, 0,
+        language.node_kind_count, language.field_count, node_count, value,
+    )
+
+
+class CachedNode(NamedTuple):
+    """One node of a :class:`CachedTree`."""
+
+    kind_id: int
+    field_id: int
+    flags: int
+    start_byte: int
+    end_byte: int
+    start_point: tuple[int, int]
+    end_point: tuple[int, int]
+    parent: int | None
+    descendant_count: int
+
+    @property
+    def is_named(self):
+        return bool(self.flags & _NAMED)
+
+    @property
+    def is_extra(self):
+        return bool(self.flags & _EXTRA)
+
+    @property
+    def is_missing(self):
+        return bool(self.flags & _MISSING)
+
+    @property
+    def has_error(self):
+        return bool(self.flags & _HAS_ERROR)
+
+
+def _walk(tree):
+    records = []
+    cursor = tree.walk()
+    parent = _NONE
+
+    # Subtree sizes are filled in on the way back up, once every descendant
+    # has been written
+    while True:
+        index = len(records)
+        records.append([cursor.node, cursor.field_id or 0, parent, 1])
+        if cursor.goto_first_child():
+            parent = index
+            continue
+        while not cursor.goto_next_sibling():
+            if not cursor.goto_parent():
+                return records
+            records[parent][3] = len(records) - parent
+            parent = records[parent][2]
+
+
+def encode_cache(tree, source):
+    """Encode ``tree``, parsed from the ``bytes`` in ``source``, as a cache."""
+    records = _walk(tree)
+    data = bytearray(_grammar_header(tree.language, len(records)))
+    data += _CONTENT.pack(content_hash(source), len(source), 0)
+    for node, field, parent, descendant_count in records:
+        flags = ((_NAMED if node.is_named else 0) | (_EXTRA if node.is_extra else 0)
+                 | (_MISSING if node.is_missing else 0) | (_HAS_ERROR if node.has_error else 0))
+        data += _NODE.pack(
+            node.kind_id, field, flags, 0, node.start_byte, node.end_byte,
+            *node.start_point, *node.end_point, parent, descendant_count,
+        )
+    return bytes(data)
+
+
+class CachedTree:
+    """A cache checked against the grammar, over ``bytes`` or a ``mmap``.
+
+    Node 0 is the root, and the children of a node follow it in order.
+    Raises ``ValueError`` if ``data`` is not a cache, is damaged, or was
+    written by another version of the format or of ``language`` (a
+    ``tree_sitter.Language``). If ``source`` is given, the cache must also
+    have been written for exactly that document; callers that key their
+    cache files by :func:`content_hash` already can leave it out.
+    """
+
+    def __init__(self, data, language, source=None):
+        view = memoryview(data)
+        header_size = _GRAMMAR.size + _CONTENT.size
+        if len(view) < header_size:
+            raise ValueError("not a valid parse tree cache")
+        magic, format_version = _GRAMMAR.unpack_from(view)[:2]
+        if magic != _MAGIC or format_version != _FORMAT:
+            raise ValueError("not a valid parse tree cache")
+
+        node_count = _GRAMMAR.unpack_from(view)[9]
+        if view[:_GRAMMAR.size] != _grammar_header(language, node_count):
+            raise ValueError("parse tree cache was written for another grammar version")
+
+        if source is not None:
+            hashed, length, _ = _CONTENT.unpack_from(view, _GRAMMAR.size)
+            if length != len(source) or hashed != content_hash(source):
+                raise ValueError("parse tree cache was written for another document")
+
+        self._nodes = view[header_size:header_size + node_count * _NODE.size]
+        if len(self._nodes) != node_count * _NODE.size or not self._is_consistent():
+            raise ValueError("not a valid parse tree cache")
+
+    def _raw(self, index):
+        return _NODE.unpack_from(self._nodes, index * _NODE.size)
+
+    def _is_consistent(self):
+        # Every subtree has to fit inside its parent's, so that navigation
+        # never leaves the node array, however the data was damaged
+        count = self.node_count
+        if count == 0:
+            return False
+        sizes = [0] * count
+        for index in range(count):
+            raw = self._raw(index)
+            parent, size = raw[10], raw[11]
+            if index == 0:
+                if parent != _NONE or size != count:
+                    return False
+            elif parent >= index or not 0 < size <= sizes[parent] - (index - parent):
+                return False
+            sizes[index] = size
+        return True
+
+    @property
+    def node_count(self):
+        """The number of nodes in the tree."""
+        return len(self._nodes) // _NODE.size
+
+    def node(self, index):
+        """The :class:`CachedNode` at ``index``."""
+        if not 0 <= index < self.node_count:
+            raise IndexError("node index out of range")
+        raw = self._raw(index)
+        return CachedNode(
+            raw[0], raw[1], raw[2], raw[4], raw[5], (raw[6], raw[7]), (raw[8], raw[9]),
+            None if raw[10] == _NONE else raw[10], raw[11],
+        )
+
+    def first_child(self, index):
+        """The index of the first child of the node at ``index``, or ``None``."""
+        return index + 1 if self._raw(index)[11] > 1 else None
+
+    def next_sibling(self, index):
+        """The index of the next sibling of the node at ``index``, or ``None``."""
+        raw = self._raw(index)
+        parent, next_index = raw[10], index + raw[11]
+        if parent == _NONE or next_index >= parent + self._raw(parent)[11]:
+            return None
+        return next_index
+
+    def children(self, index):
+        """The indices of the children of the node at ``index``, in order."""
+        child = self.first_child(index)
+        while child is not None:
+            yield child
+            child = self.next_sibling(child)
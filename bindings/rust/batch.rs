@@ -0,0 +1,66 @@
+//! Multithreaded batch parsing for indexing many documents at once.
+
+use std::num::NonZeroUsize;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::thread;
+
+use tree_sitter::{LanguageError, Parser, Tree};
+
+/// Parses every document in `sources` across up to `threads` threads, one per
+/// available CPU when `None`.
+///
+/// The calling thread takes part, and each thread owns one [`Parser`] that it
+/// reuses for every document it picks up. Threads take the next unparsed
+/// document as they finish, so a few large files do not hold up the rest of
+/// the batch.
+///
+/// The result has one entry per source, in order; an entry is `None` if that
+/// document could not be parsed.
+///
+/// ```
+/// let sources = ["<p>@Model.Name</p>", "<h1>Title</h1>"];
+/// let trees = tree_sitter_razor::parse_batch(&sources, None).unwrap();
+/// assert!(trees.iter().all(|tree| !tree.as_ref().unwrap().root_node().has_error()));
+/// ```
+pub fn parse_batch<S>(sources: &[S], threads: Option<NonZeroUsize>) -> Result<Vec<Option<Tree>>, LanguageError>
+where
+    S: AsRef<[u8]> + Sync,
+{
+    // Fail up front rather than in every worker
+    Parser::new().set_language(&crate::LANGUAGE.into())?;
+
+    let threads = threads
+        .or_else(|| thread::available_parallelism().ok())
+        .map_or(1, NonZeroUsize::get)
+        .min(sources.len().max(1));
+    let next = AtomicUsize::new(0);
+
+    let worker = || {
+        let mut parser = Parser::new();
+        parser
+            .set_language(&crate::LANGUAGE.into())
+            .expect("Error loading Razor parser");
+        let mut parsed = Vec::new();
+        loop {
+            let index = next.fetch_add(1, Ordering::Relaxed);
+            let Some(source) = sources.get(index) else {
+                break;
+            };
+            parsed.push((index, parser.parse(source, None)));
+        }
+        parsed
+    };
+
+    let mut trees: Vec<Option<Tree>> = (0..sources.len()).map(|_| None).collect();
+    thread::scope(|scope| {
+        let handles: Vec<_> = (1..threads).map(|_| scope.spawn(&worker)).collect();
+        let mut parsed = worker();
+        for handle in handles {
+            parsed.extend(handle.join().expect("batch parse worker panicked"));
+        }
+        for (index, tree) in parsed {
+            trees[index] = tree;
+        }
+    });
+    Ok(trees)
+}
@@ -1,3 +1,17 @@
+use std::env;
+
+// Optimized builds, following the make and CMake settings of the same names:
+//
+//   TREE_SITTER_RAZOR_LTO=1            compile with -flto
+//   TREE_SITTER_RAZOR_PGO_USE=<path>   a Clang profile (default.profdata, or
+//                                      the directory holding it) from
+//                                      `make pgo` or the pgo-train target
+//   TREE_SITTER_RAZOR_PARSER_OPT=-O2   optimization flag for parser.c alone
+fn setting(name: &str) -> Option<String> {
+    println!("cargo:rerun-if-env-changed={name}");
+    env::var(name).ok().filter(|value| !value.is_empty() && value != "0")
+}
+
 fn main() {
     let src_dir = std::path::Path::new("src");
 
@@ -7,14 +21,39 @@ fn main() {
     #[cfg(target_env = "msvc")]
     c_config.flag("-utf-8");
 
+    if setting("TREE_SITTER_RAZOR_LTO").is_some() {
+        // Fat objects still link when the final link is not LTO; a full
+        // cross-language link needs Clang and -Clinker-plugin-lto
+        c_config.flag_if_supported("-flto");
+        c_config.flag_if_supported("-ffat-lto-objects");
+    }
+    if let Some(profile) = setting("TREE_SITTER_RAZOR_PGO_USE") {
+        // GCC profiles are tied to the objects that wrote them
+        if c_config.get_compiler().is_like_clang() {
+            c_config.flag(&format!("-fprofile-use={profile}"));
+            c_config.flag_if_supported("-Wno-profile-instr-out-of-date");
+            println!("cargo:rerun-if-changed={profile}");
+        } else {
+            println!("cargo:warning=TREE_SITTER_RAZOR_PGO_USE needs a Clang compiler; building without the profile");
+        }
+    }
+
     let parser_path = src_dir.join("parser.c");
-    c_config.file(&parser_path);
     println!("cargo:rerun-if-changed={}", parser_path.to_str().unwrap());
+    if let Some(opt) = setting("TREE_SITTER_RAZOR_PARSER_OPT") {
+        c_config.clone().file(&parser_path).flag(&opt).compile("tree-sitter-razor-parser");
+    } else {
+        c_config.file(&parser_path);
+    }
 
     let scanner_path = src_dir.join("scanner.c");
     if scanner_path.exists() {
         c_config.file(&scanner_path);
         println!("cargo:rerun-if-changed={}", scanner_path.to_str().unwrap());
+        // Headers the scanner includes
+        for header in ["razor_text.h", "unicode.h"] {
+            println!("cargo:rerun-if-changed={}", src_dir.join(header).to_str().unwrap());
+        }
     }
 
     c_config.compile("tree-sitter-razor");
@@ -0,0 +1,330 @@
+//! Binary parse tree caches that are walked in place, without parsing the
+//! document again.
+//!
+//! The format is the one described in `tree_sitter/tree-sitter-razor-cache.h`,
+//! little-endian: a 48-byte header followed by one 40-byte record per visible
+//! node in pre-order, each with the size of its subtree. Caches written here
+//! and by the C library can be read by either.
+
+use std::error::Error;
+use std::fmt;
+
+use tree_sitter::{Language, Point, Tree};
+
+const MAGIC: u32 = 0x5A52_5354; // "TSRZ"
+const FORMAT: u16 = 1;
+const HEADER_SIZE: usize = 48;
+const NODE_SIZE: usize = 40;
+const NONE: u32 = u32::MAX;
+
+const NAMED: u16 = 1 << 0;
+const EXTRA: u16 = 1 << 1;
+const MISSING: u16 = 1 << 2;
+const HAS_ERROR: u16 = 1 << 3;
+
+const FNV_OFFSET_BASIS: u64 = 0xcbf2_9ce4_8422_2325;
+const FNV_PRIME: u64 = 0x0000_0100_0000_01b3;
+
+fn fnv1a(hash: u64, bytes: &[u8]) -> u64 {
+    bytes
+        .iter()
+        .fold(hash, |hash, &byte| (hash ^ u64::from(byte)).wrapping_mul(FNV_PRIME))
+}
+
+/// The 64-bit FNV-1a hash of a document, the key caches are checked against.
+pub fn content_hash(source: &[u8]) -> u64 {
+    fnv1a(FNV_OFFSET_BASIS, source)
+}
+
+/// Every name with its terminating NUL, symbols first, so that any change to
+/// which ID means what changes the hash
+fn grammar_hash(language: &Language) -> u64 {
+    let mut hash = FNV_OFFSET_BASIS;
+    for id in 0..language.node_kind_count() {
+        hash = fnv1a(
+            hash,
+            language.node_kind_for_id(id as u16).unwrap_or_default().as_bytes(),
+        );
+        hash = fnv1a(hash, &[0]);
+    }
+    for id in 1..=language.field_count() {
+        hash = fnv1a(
+            hash,
+            language.field_name_for_id(id as u16).unwrap_or_default().as_bytes(),
+        );
+        hash = fnv1a(hash, &[0]);
+    }
+    hash
+}
+
+/// The first 32 header bytes, which depend only on the grammar and the node
+/// count
+fn grammar_header(language: &Language, node_count: u32) -> Vec<u8> {
+    let version = language.metadata().map_or([0; 3], |metadata| {
+        [metadata.major_version, metadata.minor_version, metadata.patch_version]
+    });
+    let mut header = Vec::with_capacity(HEADER_SIZE);
+    header.extend_from_slice(&MAGIC.to_le_bytes());
+    header.extend_from_slice(&FORMAT.to_le_bytes());
+    header.extend_from_slice(&(language.abi_version() as u16).to_le_bytes());
+    header.extend_from_slice(&version);
+    header.push(0);
+    header.extend_from_slice(&(language.node_kind_count() as u32).to_le_bytes());
+    header.extend_from_slice(&(language.field_count() as u32).to_le_bytes());
+    header.extend_from_slice(&node_count.to_le_bytes());
+    header.extend_from_slice(&grammar_hash(language).to_le_bytes());
+    header
+}
+
+/// Encodes `tree`, parsed from `source`, as a cache.
+pub fn encode_cache(tree: &Tree, source: &[u8]) -> Vec<u8> {
+    let mut nodes = Vec::new();
+    let mut cursor = tree.walk();
+    let mut parent = NONE;
+
+    // Subtree sizes are filled in on the way back up, once every descendant
+    // has been written
+    'walk: loop {
+        let index = nodes.len() as u32;
+        let field = cursor.field_id().map_or(0, |id| id.get());
+        nodes.push((cursor.node(), field, parent, 1u32));
+
+        if cursor.goto_first_child() {
+            parent = index;
+            continue;
+        }
+        while !cursor.goto_next_sibling() {
+            if !cursor.goto_parent() {
+                break 'walk;
+            }
+            let count = nodes.len() as u32;
+            let finished = &mut nodes[parent as usize];
+            finished.3 = count - parent;
+            parent = finished.2;
+        }
+    }
+
+    let mut data = grammar_header(&tree.language(), nodes.len() as u32);
+    data.extend_from_slice(&content_hash(source).to_le_bytes());
+    data.extend_from_slice(&(source.len() as u32).to_le_bytes());
+    data.extend_from_slice(&0u32.to_le_bytes());
+
+    data.reserve(nodes.len() * NODE_SIZE);
+    for (node, field, parent, descendant_count) in nodes {
+        let flags = (if node.is_named() { NAMED } else { 0 })
+            | (if node.is_extra() { EXTRA } else { 0 })
+            | (if node.is_missing() { MISSING } else { 0 })
+            | (if node.has_error() { HAS_ERROR } else { 0 });
+        let (start, end) = (node.start_position(), node.end_position());
+        data.extend_from_slice(&node.kind_id().to_le_bytes());
+        data.extend_from_slice(&field.to_le_bytes());
+        data.extend_from_slice(&flags.to_le_bytes());
+        data.extend_from_slice(&0u16.to_le_bytes());
+        for value in [
+            node.start_byte(),
+            node.end_byte(),
+            start.row,
+            start.column,
+            end.row,
+            end.column,
+        ] {
+            data.extend_from_slice(&(value as u32).to_le_bytes());
+        }
+        data.extend_from_slice(&parent.to_le_bytes());
+        data.extend_from_slice(&descendant_count.to_le_bytes());
+    }
+    data
+}
+
+/// Why a cache could not be opened.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum CacheError {
+    /// The data is not a cache of this format version, or is damaged.
+    Invalid,
+    /// The cache was written for another version of the grammar.
+    Grammar,
+    /// The cache was written for another document.
+    Content,
+}
+
+impl fmt::Display for CacheError {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.write_str(match self {
+            Self::Invalid => "not a valid parse tree cache",
+            Self::Grammar => "parse tree cache was written for another grammar version",
+            Self::Content => "parse tree cache was written for another document",
+        })
+    }
+}
+
+impl Error for CacheError {}
+
+/// One node of a [`CachedTree`].
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub struct CachedNode {
+    /// The node's [`kind_id`](tree_sitter::Node::kind_id); `ERROR` is 65535.
+    pub kind_id: u16,
+    /// The node's field in its parent, 0 if none.
+    pub field_id: u16,
+    pub start_byte: usize,
+    pub end_byte: usize,
+    pub start_position: Point,
+    pub end_position: Point,
+    /// The index of the parent, `None` for the root.
+    pub parent: Option<usize>,
+    /// The number of nodes in the subtree, this one included.
+    pub descendant_count: usize,
+    flags: u16,
+}
+
+impl CachedNode {
+    pub fn is_named(&self) -> bool {
+        self.flags & NAMED != 0
+    }
+
+    pub fn is_extra(&self) -> bool {
+        self.flags & EXTRA != 0
+    }
+
+    pub fn is_missing(&self) -> bool {
+        self.flags & MISSING != 0
+    }
+
+    pub fn has_error(&self) -> bool {
+        self.flags & HAS_ERROR != 0
+    }
+
+    pub fn byte_range(&self) -> std::ops::Range<usize> {
+        self.start_byte..self.end_byte
+    }
+}
+
+/// A cache checked against the grammar, borrowed from a buffer or a mapping.
+///
+/// Node 0 is the root, and the children of a node follow it in order.
+///
+/// ```
+/// let source: &[u8] = b"<p>@Model.Name</p>";
+/// let language = tree_sitter_razor::LANGUAGE.into();
+/// let mut parser = tree_sitter::Parser::new();
+/// parser.set_language(&language).unwrap();
+/// let tree = parser.parse(source, None).unwrap();
+///
+/// let data = tree_sitter_razor::encode_cache(&tree, source);
+/// let cache = tree_sitter_razor::CachedTree::open(&data, &language, Some(source)).unwrap();
+/// let root = cache.node(0);
+/// assert_eq!(language.node_kind_for_id(root.kind_id), Some("compilation_unit"));
+/// assert_eq!(root.descendant_count, cache.node_count());
+/// ```
+pub struct CachedTree<'a> {
+    nodes: &'a [u8],
+}
+
+fn read_u16(data: &[u8], offset: usize) -> u16 {
+    u16::from_le_bytes([data[offset], data[offset + 1]])
+}
+
+fn read_u32(data: &[u8], offset: usize) -> u32 {
+    u32::from_le_bytes([data[offset], data[offset + 1], data[offset + 2], data[offset + 3]])
+}
+
+fn read_u64(data: &[u8], offset: usize) -> u64 {
+    u64::from(read_u32(data, offset)) | (u64::from(read_u32(data, offset + 4)) << 32)
+}
+
+impl<'a> CachedTree<'a> {
+    /// Checks `data` and opens it as a cache of a tree parsed with
+    /// `language`. If `source` is given, the cache must also have been
+    /// written for exactly that document; callers that key their cache files
+    /// by [`content_hash`] already can pass `None`.
+    pub fn open(data: &'a [u8], language: &Language, source: Option<&[u8]>) -> Result<Self, CacheError> {
+        if data.len() < HEADER_SIZE || read_u32(data, 0) != MAGIC || read_u16(data, 4) != FORMAT {
+            return Err(CacheError::Invalid);
+        }
+
+        let node_count = read_u32(data, 20);
+        if data[..32] != grammar_header(language, node_count)[..] {
+            return Err(CacheError::Grammar);
+        }
+
+        if let Some(source) = source {
+            if read_u64(data, 32) != content_hash(source) || read_u32(data, 40) as usize != source.len() {
+                return Err(CacheError::Content);
+            }
+        }
+
+        let node_count = node_count as usize;
+        let nodes = data[HEADER_SIZE..]
+            .get(..node_count.checked_mul(NODE_SIZE).ok_or(CacheError::Invalid)?)
+            .ok_or(CacheError::Invalid)?;
+        let cache = Self { nodes };
+        if !cache.is_consistent() {
+            return Err(CacheError::Invalid);
+        }
+        Ok(cache)
+    }
+
+    /// Every subtree has to fit inside its parent's, so that navigation never
+    /// leaves the node array, however the data was damaged
+    fn is_consistent(&self) -> bool {
+        let count = self.node_count();
+        if count == 0 || self.raw_parent(0) != NONE || self.raw_descendant_count(0) != count {
+            return false;
+        }
+        (1..count).all(|index| {
+            let parent = self.raw_parent(index) as usize;
+            parent < index && {
+                let room = self.raw_descendant_count(parent).saturating_sub(index - parent);
+                let size = self.raw_descendant_count(index);
+                size > 0 && size <= room
+            }
+        })
+    }
+
+    fn raw_parent(&self, index: usize) -> u32 {
+        read_u32(self.nodes, index * NODE_SIZE + 32)
+    }
+
+    fn raw_descendant_count(&self, index: usize) -> usize {
+        read_u32(self.nodes, index * NODE_SIZE + 36) as usize
+    }
+
+    /// The number of nodes in the tree.
+    pub fn node_count(&self) -> usize {
+        self.nodes.len() / NODE_SIZE
+    }
+
+    /// The node at `index`. Panics if there is no such node.
+    pub fn node(&self, index: usize) -> CachedNode {
+        let record = &self.nodes[index * NODE_SIZE..(index + 1) * NODE_SIZE];
+        let parent = read_u32(record, 32);
+        CachedNode {
+            kind_id: read_u16(record, 0),
+            field_id: read_u16(record, 2),
+            flags: read_u16(record, 4),
+            start_byte: read_u32(record, 8) as usize,
+            end_byte: read_u32(record, 12) as usize,
+            start_position: Point::new(read_u32(record, 16) as usize, read_u32(record, 20) as usize),
+            end_position: Point::new(read_u32(record, 24) as usize, read_u32(record, 28) as usize),
+            parent: (parent != NONE).then_some(parent as usize),
+            descendant_count: read_u32(record, 36) as usize,
+        }
+    }
+
+    /// The index of the first child of the node at `index`.
+    pub fn first_child(&self, index: usize) -> Option<usize> {
+        (self.raw_descendant_count(index) > 1).then_some(index + 1)
+    }
+
+    /// The index of the next sibling of the node at `index`.
+    pub fn next_sibling(&self, index: usize) -> Option<usize> {
+        let parent = self.raw_parent(index);
+        let next = index + self.raw_descendant_count(index);
+        (parent != NONE && next < parent as usize + self.raw_descendant_count(parent as usize)).then_some(next)
+    }
+
+    /// The indices of the children of the node at `index`, in order.
+    pub fn children(&self, index: usize) -> impl Iterator<Item = usize> + '_ {
+        std::iter::successors(self.first_child(index), move |&child| self.next_sibling(child))
+    }
+}
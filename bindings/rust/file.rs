@@ -0,0 +1,101 @@
+//! Zero-copy parsing of documents straight from a memory mapping.
+
+use std::fs::File;
+use std::io;
+use std::path::Path;
+
+use memmap2::Mmap;
+use tree_sitter::{Node, Parser, Tree};
+
+/// The encoding of a [`MappedFile`], detected from its byte order mark.
+/// Files without one are read as UTF-8.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum Encoding {
+    Utf8,
+    Utf16Le,
+    Utf16Be,
+}
+
+/// A document mapped read-only into memory.
+///
+/// The byte ranges of trees parsed from the file are relative to
+/// [`contents`](Self::contents), which starts just past the byte order mark,
+/// so [`node_text`](Self::node_text) slices the mapping without copying.
+pub struct MappedFile {
+    map: Option<Mmap>,
+    start: usize,
+    encoding: Encoding,
+}
+
+impl MappedFile {
+    /// Maps the file at `path`.
+    ///
+    /// The file must not be modified while it is mapped; doing so is
+    /// undefined behaviour, as with any memory mapping.
+    pub fn open(path: impl AsRef<Path>) -> io::Result<Self> {
+        let file = File::open(path)?;
+        let length = file.metadata()?.len();
+        if length > u64::from(u32::MAX) {
+            return Err(io::Error::new(io::ErrorKind::InvalidData, "file is larger than 4GB"));
+        }
+
+        // Empty files cannot be mapped, but are valid documents
+        let map = if length == 0 {
+            None
+        } else {
+            // SAFETY: see the note on modification above
+            Some(unsafe { Mmap::map(&file)? })
+        };
+
+        let bytes = map.as_deref().unwrap_or_default();
+        let (start, encoding) = match bytes {
+            [0xEF, 0xBB, 0xBF, ..] => (3, Encoding::Utf8),
+            [0xFF, 0xFE, ..] => (2, Encoding::Utf16Le),
+            [0xFE, 0xFF, ..] => (2, Encoding::Utf16Be),
+            _ => (0, Encoding::Utf8),
+        };
+        Ok(Self { map, start, encoding })
+    }
+
+    /// The document bytes, without the byte order mark.
+    pub fn contents(&self) -> &[u8] {
+        self.map.as_deref().map_or(&[], |bytes| &bytes[self.start..])
+    }
+
+    pub fn encoding(&self) -> Encoding {
+        self.encoding
+    }
+
+    /// Parses the document with `parser`, which must already have the Razor
+    /// language set. The parser reads straight from the mapping, decoding
+    /// UTF-16 itself when that is what the file holds.
+    pub fn parse(&self, parser: &mut Parser, old_tree: Option<&Tree>) -> Option<Tree> {
+        let contents = self.contents();
+        match self.encoding {
+            Encoding::Utf8 => parser.parse_with_options(
+                &mut |offset, _| contents.get(offset..).unwrap_or_default(),
+                old_tree,
+                None,
+            ),
+            Encoding::Utf16Le | Encoding::Utf16Be => {
+                // SAFETY: any bit pattern is a valid u16. The mapping is page
+                // aligned and the mark is two bytes, so nothing is left over
+                // in front; the parser is told the byte order, so the units
+                // are passed through as raw bytes.
+                let (prefix, units, _) = unsafe { contents.align_to::<u16>() };
+                debug_assert!(prefix.is_empty());
+                let mut read = |offset: usize, _| units.get(offset..).unwrap_or_default();
+                if self.encoding == Encoding::Utf16Le {
+                    parser.parse_utf16_le_with_options(&mut read, old_tree, None)
+                } else {
+                    parser.parse_utf16_be_with_options(&mut read, old_tree, None)
+                }
+            }
+        }
+    }
+
+    /// The bytes of `node`, borrowed from the mapping.
+    pub fn node_text(&self, node: Node) -> &[u8] {
+        &self.contents()[node.byte_range()]
+    }
+}
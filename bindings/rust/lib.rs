@@ -15,11 +15,42 @@
 //! assert!(!tree.root_node().has_error());
 //! ```
 //!
+//! With the `batch` feature, [`parse_batch`] parses many documents at once on a
+//! pool of threads. With the `mmap` feature, [`MappedFile`] parses a document
+//! straight from a memory mapping. With the `stream` feature, [`parse_stream`]
+//! hands out the top-level nodes of a large document one window at a time.
+//! With the `cache` feature, [`encode_cache`] saves a tree in a binary format
+//! that [`CachedTree`] walks in place in a later run.
+//!
 //! [`Parser`]: https://docs.rs/tree-sitter/0.25.10/tree_sitter/struct.Parser.html
 //! [tree-sitter]: https://tree-sitter.github.io/
 
 use tree_sitter_language::LanguageFn;
 
+#[cfg(feature = "batch")]
+mod batch;
+
+#[cfg(feature = "batch")]
+pub use batch::parse_batch;
+
+#[cfg(feature = "mmap")]
+mod file;
+
+#[cfg(feature = "mmap")]
+pub use file::{Encoding, MappedFile};
+
+#[cfg(feature = "cache")]
+mod cache;
+
+#[cfg(feature = "cache")]
+pub use cache::{content_hash, encode_cache, CacheError, CachedNode, CachedTree};
+
+#[cfg(feature = "stream")]
+mod stream;
+
+#[cfg(feature = "stream")]
+pub use stream::parse_stream;
+
 extern "C" {
     fn tree_sitter_razor() -> *const ();
 }
@@ -32,12 +63,17 @@ pub const LANGUAGE: LanguageFn = unsafe { LanguageFn::from_raw(tree_sitter_razor
 /// [`node-types.json`]: https://tree-sitter.github.io/tree-sitter/using-parsers/6-static-node-types
 pub const NODE_TYPES: &str = include_str!("../../src/node-types.json");
 
-// NOTE: uncomment these to include any queries that this grammar contains:
+/// The syntax highlighting query for this grammar.
+pub const HIGHLIGHTS_QUERY: &str = include_str!("../../queries/highlights.scm");
 
-// pub const HIGHLIGHTS_QUERY: &str = include_str!("../../queries/highlights.scm");
-// pub const INJECTIONS_QUERY: &str = include_str!("../../queries/injections.scm");
-// pub const LOCALS_QUERY: &str = include_str!("../../queries/locals.scm");
-// pub const TAGS_QUERY: &str = include_str!("../../queries/tags.scm");
+/// The language injection query for this grammar.
+pub const INJECTIONS_QUERY: &str = include_str!("../../queries/injections.scm");
+
+/// The local-variable query for this grammar.
+pub const LOCALS_QUERY: &str = include_str!("../../queries/locals.scm");
+
+/// The symbol tagging query for this grammar.
+pub const TAGS_QUERY: &str = include_str!("../../queries/tags.scm");
 
 #[cfg(test)]
 mod tests {
@@ -48,4 +84,126 @@ mod tests {
             .set_language(&super::LANGUAGE.into())
             .expect("Error loading Razor parser");
     }
+
+    #[test]
+    fn test_queries_compile() {
+        let language = super::LANGUAGE.into();
+        for source in [
+            super::HIGHLIGHTS_QUERY,
+            super::INJECTIONS_QUERY,
+            super::LOCALS_QUERY,
+            super::TAGS_QUERY,
+        ] {
+            tree_sitter::Query::new(&language, source).expect("Error compiling query");
+        }
+    }
+
+    #[cfg(feature = "batch")]
+    #[test]
+    fn test_parse_batch() {
+        let sources: Vec<String> = (0..32).map(|i| format!("<p>Item {i}</p>")).collect();
+        let trees = super::parse_batch(&sources, std::num::NonZeroUsize::new(4)).unwrap();
+        assert_eq!(trees.len(), sources.len());
+        for (source, tree) in sources.iter().zip(&trees) {
+            let root = tree.as_ref().expect("document was not parsed").root_node();
+            assert!(!root.has_error());
+            assert_eq!(root.byte_range(), 0..source.len());
+        }
+    }
+
+    #[cfg(feature = "mmap")]
+    #[test]
+    fn test_mapped_file() {
+        let path = std::env::temp_dir().join(format!("tree-sitter-razor-{}.cshtml", std::process::id()));
+        std::fs::write(&path, b"\xEF\xBB\xBF<h1>Title</h1>").unwrap();
+        let file = super::MappedFile::open(&path).unwrap();
+        std::fs::remove_file(&path).unwrap();
+
+        let mut parser = tree_sitter::Parser::new();
+        parser.set_language(&super::LANGUAGE.into()).unwrap();
+        let tree = file.parse(&mut parser, None).unwrap();
+        let root = tree.root_node();
+        assert!(!root.has_error());
+        assert_eq!(file.encoding(), super::Encoding::Utf8);
+        assert_eq!(file.node_text(root), b"<h1>Title</h1>");
+    }
+
+    #[cfg(feature = "cache")]
+    #[test]
+    fn test_cache_round_trip() {
+        let source: &[u8] = b"@page \"/\"\n<ul>@foreach (var item in Items) { <li>@item</li> }</ul>\n";
+        let language = super::LANGUAGE.into();
+        let mut parser = tree_sitter::Parser::new();
+        parser.set_language(&language).unwrap();
+        let tree = parser.parse(source, None).unwrap();
+
+        let data = super::encode_cache(&tree, source);
+        let cache = super::CachedTree::open(&data, &language, Some(source)).unwrap();
+        assert_eq!(
+            super::CachedTree::open(&data, &language, Some(&b"<p></p>"[..])).err(),
+            Some(super::CacheError::Content)
+        );
+        assert_eq!(
+            super::CachedTree::open(&data[..data.len() - 1], &language, None).err(),
+            Some(super::CacheError::Invalid)
+        );
+
+        // Walk both trees in step
+        let mut cursor = tree.walk();
+        let mut index = 0;
+        loop {
+            let node = cursor.node();
+            let cached = cache.node(index);
+            assert_eq!(cached.kind_id, node.kind_id());
+            assert_eq!(cached.field_id, cursor.field_id().map_or(0, |id| id.get()));
+            assert_eq!(cached.byte_range(), node.byte_range());
+            assert_eq!(
+                (cached.start_position, cached.end_position),
+                (node.start_position(), node.end_position())
+            );
+            assert_eq!(cached.is_named(), node.is_named());
+            assert_eq!(cache.first_child(index).is_some(), node.child_count() > 0);
+
+            index += 1;
+            if cursor.goto_first_child() {
+                continue;
+            }
+            while !cursor.goto_next_sibling() {
+                if !cursor.goto_parent() {
+                    assert_eq!(index, cache.node_count());
+                    return;
+                }
+            }
+        }
+    }
+
+    #[cfg(feature = "stream")]
+    #[test]
+    fn test_parse_stream() {
+        let source: String = (0..200).map(|i| format!("<li>@items[{i}].Name</li>\n")).collect();
+        let mut parser = tree_sitter::Parser::new();
+        parser.set_language(&super::LANGUAGE.into()).unwrap();
+
+        let mut streamed = Vec::new();
+        super::parse_stream(
+            &mut parser,
+            source.as_bytes(),
+            std::num::NonZeroUsize::new(256),
+            |node, text| {
+                assert_eq!(text, &source.as_bytes()[node.byte_range()]);
+                streamed.push((node.to_sexp(), node.byte_range(), node.start_position()));
+                true
+            },
+        )
+        .unwrap();
+
+        let tree = parser.parse(&source, None).unwrap();
+        let root = tree.root_node();
+        let mut cursor = root.walk();
+        let whole: Vec<_> = root
+            .children(&mut cursor)
+            .map(|node| (node.to_sexp(), node.byte_range(), node.start_position()))
+            .collect();
+        assert_eq!(streamed, whole);
+    }
 }
@@ -0,0 +1,142 @@
+//! Streaming parsing of large documents, one window at a time.
+
+use std::io::{self, Read};
+use std::num::NonZeroUsize;
+
+use tree_sitter::{Node, Parser, Point, Range};
+
+const DEFAULT_WINDOW_SIZE: usize = 1 << 20;
+
+/// Top-level nodes at the end of a window that are parsed again with the next
+const HELD_BACK_NODES: usize = 2;
+
+/// Parses the document read from `reader` in windows of about `window_size`
+/// bytes, 1MB when `None`, and calls `callback` with each top-level node in
+/// document order: an element, a Razor statement, a code block, a run of
+/// text and so on, or an `ERROR`. The bytes passed along are the node's
+/// source. Byte ranges and positions are relative to the whole document.
+///
+/// Each window is parsed as a tree of its own and dropped once its nodes
+/// have been handed out, so memory stays proportional to the window rather
+/// than to the document. The last two top-level nodes of a window are held
+/// back and parsed again at the start of the next one: the last may be cut
+/// off, and the one before may still be continued by what follows, such as
+/// an `@if` that an `else` after the window edge belongs to. A window that
+/// holds no more than that is doubled until it does.
+///
+/// `parser` must already have the Razor language set. Its included ranges
+/// are used to place each window in the document and are reset on return.
+/// The callback returns `false` to stop the stream.
+///
+/// ```
+/// let source = "<p>One</p>\n<p>Two</p>\n<p>Three</p>\n";
+/// let mut parser = tree_sitter::Parser::new();
+/// parser.set_language(&tree_sitter_razor::LANGUAGE.into()).unwrap();
+/// let mut kinds = Vec::new();
+/// tree_sitter_razor::parse_stream(&mut parser, source.as_bytes(), None, |node, _| {
+///     kinds.push(node.kind().to_owned());
+///     true
+/// })
+/// .unwrap();
+/// assert_eq!(kinds, ["element", "element", "element"]);
+/// ```
+pub fn parse_stream<R, F>(
+    parser: &mut Parser,
+    reader: R,
+    window_size: Option<NonZeroUsize>,
+    callback: F,
+) -> io::Result<()>
+where
+    R: Read,
+    F: FnMut(Node, &[u8]) -> bool,
+{
+    let window_size = window_size.map_or(DEFAULT_WINDOW_SIZE, NonZeroUsize::get);
+    let result = stream_windows(parser, reader, window_size, callback);
+    parser
+        .set_included_ranges(&[])
+        .expect("the default included range is always valid");
+    result
+}
+
+fn stream_windows<R, F>(parser: &mut Parser, mut reader: R, window_size: usize, mut callback: F) -> io::Result<()>
+where
+    R: Read,
+    F: FnMut(Node, &[u8]) -> bool,
+{
+    // The part of the document that has been read but not handed out
+    let mut window = Vec::new();
+    let mut start_byte = 0;
+    let mut start_point = Point::new(0, 0);
+    let mut wanted = window_size;
+
+    loop {
+        let requested = wanted.saturating_sub(window.len());
+        let read = (&mut reader).take(requested as u64).read_to_end(&mut window)?;
+        let at_end = read < requested;
+        if start_byte + window.len() >= u32::MAX as usize {
+            return Err(io::Error::new(
+                io::ErrorKind::InvalidData,
+                "document is larger than 4GB",
+            ));
+        }
+
+        let range = Range {
+            start_byte,
+            end_byte: u32::MAX as usize,
+            start_point,
+            end_point: Point::new(u32::MAX as usize, u32::MAX as usize),
+        };
+        parser
+            .set_included_ranges(&[range])
+            .map_err(|_| io::Error::new(io::ErrorKind::InvalidInput, "invalid window range"))?;
+        let tree = parser
+            .parse_with_options(
+                &mut |byte: usize, _| {
+                    byte.checked_sub(start_byte)
+                        .and_then(|offset| window.get(offset..))
+                        .unwrap_or_default()
+                },
+                None,
+                None,
+            )
+            .ok_or_else(|| io::Error::other("window could not be parsed"))?;
+
+        // Only the end of the document is known to be final
+        let root = tree.root_node();
+        let held_back = if at_end { 0 } else { HELD_BACK_NODES };
+        let mut handed_out = start_byte;
+        let mut cursor = root.walk();
+        for node in root
+            .children(&mut cursor)
+            .take(root.child_count().saturating_sub(held_back))
+        {
+            let range = node.byte_range();
+            handed_out = range.end;
+            if !callback(node, &window[range.start - start_byte..range.end - start_byte]) {
+                return Ok(());
+            }
+        }
+
+        if at_end {
+            return Ok(());
+        }
+
+        // Read another window's worth past what is held back, or double the
+        // window if nothing could be handed out
+        if handed_out > start_byte {
+            let dropped = handed_out - start_byte;
+            match window[..dropped].iter().rposition(|&byte| byte == b'\n') {
+                Some(last) => {
+                    start_point.row += window[..dropped].iter().filter(|&&byte| byte == b'\n').count();
+                    start_point.column = dropped - last - 1;
+                }
+                None => start_point.column += dropped,
+            }
+            window.drain(..dropped);
+            start_byte = handed_out;
+            wanted = window.len().saturating_add(window_size);
+        } else {
+            wanted = window.len().saturating_add(window.len().max(window_size));
+        }
+    }
+}
@@ -0,0 +1,26 @@
+type Runtime<L> = {
+  Parser: { init(options?: object): Promise<void> };
+  Language: { load(input: Uint8Array): Promise<L> };
+};
+
+type LoadOptions = {
+  /** Where tree-sitter-razor.wasm is served from; next to this package's root by default. */
+  url?: string | URL;
+  /** Passed to `Parser.init`, for example to locate web-tree-sitter's own module. */
+  runtime?: object;
+  /** Called with the number of bytes received so far as the grammar downloads. */
+  onProgress?: (received: number) => void;
+};
+
+/**
+ * Initializes web-tree-sitter and loads the Razor language, downloading the
+ * grammar at the same time as the runtime starts up.
+ *
+ * ```js
+ * import { Parser, Language } from "web-tree-sitter";
+ * import { loadRazor } from "tree-sitter-razor/bindings/web/index.mjs";
+ *
+ * const Razor = await loadRazor({ Parser, Language });
+ * ```
+ */
+export function loadRazor<L>(runtime: Runtime<L>, options?: LoadOptions): Promise<L>;
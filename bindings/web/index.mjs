@@ -0,0 +1,53 @@
+// Loading the grammar in a browser with web-tree-sitter
+//
+// web-tree-sitter compiles a language from its bytes, so the module cannot
+// be compiled while it streams in. Everything around that can overlap: the
+// grammar is fetched while the runtime's own module is fetched and
+// compiled, and its body is copied into place chunk by chunk as it arrives,
+// so compilation starts the moment the last byte is in.
+
+const DEFAULT_URL = new URL("../../tree-sitter-razor.wasm", import.meta.url);
+
+async function fetchBytes(url, onProgress) {
+  const response = await fetch(url);
+  if (!response.ok) {
+    throw new Error(`failed to fetch ${url}: ${response.status} ${response.statusText}`);
+  }
+  if (!response.body) {
+    return new Uint8Array(await response.arrayBuffer());
+  }
+
+  // With Content-Encoding the length is of the compressed body, so it is
+  // only a first guess at the size
+  let bytes = new Uint8Array(Number(response.headers.get("Content-Length")) || 1 << 20);
+  let length = 0;
+  const reader = response.body.getReader();
+  for (;;) {
+    const { done, value } = await reader.read();
+    if (done) {
+      break;
+    }
+    if (length + value.length > bytes.length) {
+      const grown = new Uint8Array(Math.max(2 * bytes.length, length + value.length));
+      grown.set(bytes.subarray(0, length));
+      bytes = grown;
+    }
+    bytes.set(value, length);
+    length += value.length;
+    onProgress?.(length);
+  }
+  return bytes.subarray(0, length);
+}
+
+/**
+ * Initializes web-tree-sitter and loads the Razor language, downloading the
+ * grammar at the same time as the runtime starts up.
+ */
+export async function loadRazor({ Parser, Language }, { url = DEFAULT_URL, runtime, onProgress } = {}) {
+  const bytes = fetchBytes(url, onProgress);
+  // Handled here as well so that a failed download is not reported as
+  // unhandled while the runtime is still starting
+  bytes.catch(() => {});
+  await Parser.init(runtime);
+  return Language.load(await bytes);
+}
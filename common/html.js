@@ -0,0 +1,377 @@
+/**
+ * @file HTML and Razor markup rules shared by the Razor grammars
+ * @author Jeffrey Crochet <jlcrochet91@pm.me>
+ * @license MIT
+ *
+ * Both the full grammar and the split grammar (split/grammar.js) spread these
+ * rules into their own. Each grammar supplies the Razor transitions they refer
+ * to (razor_directive, razor_code_block, razor_statement,
+ * razor_explicit_expression and razor_implicit_expression) and the external
+ * text and raw-content tokens.
+ */
+
+/// <reference types="tree-sitter-cli/dsl" />
+// @ts-check
+
+module.exports = {
+  // HTML DOCTYPE declaration
+  // The !DOCTYPE... part must be immediate after < and have higher precedence than opt-out !
+  doctype: $ => seq(
+    '<',
+    token.immediate(prec(10, /![Dd][Oo][Cc][Tt][Yy][Pp][Ee][^>]*/)),
+    '>',
+  ),
+
+  // @@ escapes to a literal @ character
+  escaped_at: _ => '@@',
+
+  // =========================================================================
+  // Tag Names
+  // =========================================================================
+
+  // Every tag name has the same precedence, so the lexer takes the longest
+  // name after < or </: <InputText>, <colgroup> and <TitleBar> are not cut
+  // short at input, col and title, and <My-Widget> is not cut short at the
+  // component name My. Names of the same length go to the rule defined
+  // first, so the void and raw-text names come before the component name
+  // and the component name before the element name.
+
+  // Case-insensitive void element names
+  _void_element_name: _ => token.immediate(choice(
+    /area/i,
+    /base/i,
+    /br/i,
+    /col/i,
+    /embed/i,
+    /hr/i,
+    /img/i,
+    /input/i,
+    /link/i,
+    /meta/i,
+    /source/i,
+    /track/i,
+    /wbr/i,
+  )),
+
+  _script_name: _ => token.immediate(/script/i),
+
+  _style_name: _ => token.immediate(/style/i),
+
+  _title_name: _ => token.immediate(/title/i),
+
+  _textarea_name: _ => token.immediate(/textarea/i),
+
+  _component_name: _ => token.immediate(/[A-Z][A-Z0-9_]*[a-z][a-zA-Z0-9_]*(\.[a-zA-Z_][a-zA-Z0-9_]*)*/),
+
+  // Element name that must immediately follow < or </ (or ! if opt-out)
+  _immediate_element_name: _ => token.immediate(/[a-zA-Z][a-zA-Z0-9:-]*/),
+
+  element_name: _ => /[a-zA-Z][a-zA-Z0-9:-]*/,
+
+  // =========================================================================
+  // HTML Elements
+  // =========================================================================
+
+  // Use token.immediate() to ensure no whitespace between < and element name
+  // This prevents "< div>" from being parsed as valid HTML
+
+  // Element content uses _element_content which doesn't stop at else/catch/finally
+  element: $ => seq(
+    $.start_tag,
+    repeat($._element_content),
+    $.end_tag,
+  ),
+
+  // Void elements are HTML elements that cannot have content and must not have an end tag
+  // https://html.spec.whatwg.org/multipage/syntax.html#void-elements
+  // area, base, br, col, embed, hr, img, input, link, meta, source, track, wbr
+  void_element: $ => seq(
+    '<',
+    optional($._tag_helper_opt_out),
+    field('name', alias($._void_element_name, $.element_name)),
+    repeat($._html_attribute),
+    optional('/'),
+    token.immediate('>'),
+  ),
+
+  // Content inside elements - doesn't need keyword awareness
+  _element_content: $ => choice(
+    $.script_element,
+    $.style_element,
+    $.title_element,
+    $.textarea_element,
+    $.element,
+    $.self_closing_element,
+    $.component_element,
+    $.self_closing_component,
+    $.void_element,
+    $.html_comment,
+    $.razor_comment,
+    $.razor_directive,
+    $.razor_code_block,
+    $.razor_statement,
+    $.razor_explicit_expression,
+    $.razor_implicit_expression,
+    $.escaped_at,
+    $.text,  // Regular text, not keyword-aware
+  ),
+
+  self_closing_element: $ => seq(
+    '<',
+    optional($._tag_helper_opt_out),
+    field('name', alias($._immediate_element_name, $.element_name)),
+    repeat($._html_attribute),
+    '/',
+    token.immediate('>'),
+  ),
+
+  start_tag: $ => seq(
+    '<',
+    optional($._tag_helper_opt_out),
+    field('name', alias($._immediate_element_name, $.element_name)),
+    repeat($._html_attribute),
+    '>',
+  ),
+
+  end_tag: $ => seq(
+    '</',
+    optional($._tag_helper_opt_out),
+    field('name', alias($._immediate_element_name, $.element_name)),
+    '>',
+  ),
+
+  // Tag Helper opt-out character - must immediately follow < or </
+  _tag_helper_opt_out: _ => token.immediate('!'),
+
+  // =========================================================================
+  // Components
+  // =========================================================================
+
+  // Blazor components are told apart from HTML by their name alone, as the
+  // Razor compiler does: an upper-case letter followed somewhere by a
+  // lower-case one (<EditForm>, <InputText>, <Shared.NavMenu>), so that
+  // <DIV> and <H1> stay HTML. Void and raw-text element names win a tie, so
+  // <Input> and <Title> stay HTML as well (see Tag Names). Tag helpers
+  // depend on the @addTagHelper and @tagHelperPrefix directives in effect,
+  // so they are left to queries.
+  component_element: $ => seq(
+    alias($._component_start_tag, $.start_tag),
+    repeat($._element_content),
+    alias($._component_end_tag, $.end_tag),
+  ),
+
+  self_closing_component: $ => seq(
+    '<',
+    field('name', alias($._component_name, $.component_name)),
+    repeat($._html_attribute),
+    '/',
+    token.immediate('>'),
+  ),
+
+  _component_start_tag: $ => seq(
+    '<',
+    field('name', alias($._component_name, $.component_name)),
+    repeat($._html_attribute),
+    '>',
+  ),
+
+  _component_end_tag: $ => seq(
+    '</',
+    field('name', alias($._component_name, $.component_name)),
+    '>',
+  ),
+
+  // =========================================================================
+  // Script and Style Elements
+  // =========================================================================
+
+  // Script elements contain raw JavaScript content that shouldn't be parsed as HTML
+  // Higher precedence than regular elements to ensure <script> is matched first
+  script_element: $ => prec(1, seq(
+    $.script_start_tag,
+    optional($.script_content),
+    $.script_end_tag,
+  )),
+
+  script_start_tag: $ => seq(
+    '<',
+    alias($._script_name, $.element_name),
+    repeat($._html_attribute),
+    '>',
+  ),
+
+  script_end_tag: $ => seq(
+    '</',
+    alias($._script_name, $.element_name),
+    '>',
+  ),
+
+  // The scanner hands raw text out in bounded chunks (see razor_text.h) so
+  // that an edit only re-lexes the chunk it is in; they make up one node
+  script_content: $ => repeat1($._script_content),
+
+  // Style elements contain raw CSS content that shouldn't be parsed as HTML
+  // Higher precedence than regular elements to ensure <style> is matched first
+  style_element: $ => prec(1, seq(
+    $.style_start_tag,
+    optional($.style_content),
+    $.style_end_tag,
+  )),
+
+  style_start_tag: $ => seq(
+    '<',
+    alias($._style_name, $.element_name),
+    repeat($._html_attribute),
+    '>',
+  ),
+
+  style_end_tag: $ => seq(
+    '</',
+    alias($._style_name, $.element_name),
+    '>',
+  ),
+
+  style_content: $ => repeat1($._style_content),
+
+  // Title elements contain raw text (but can have character references)
+  // Higher precedence than regular elements to ensure <title> is matched first
+  title_element: $ => prec(1, seq(
+    $.title_start_tag,
+    optional($.title_content),
+    $.title_end_tag,
+  )),
+
+  title_start_tag: $ => seq(
+    '<',
+    alias($._title_name, $.element_name),
+    repeat($._html_attribute),
+    '>',
+  ),
+
+  title_end_tag: $ => seq(
+    '</',
+    alias($._title_name, $.element_name),
+    '>',
+  ),
+
+  // Title content is raw text - doesn't contain child elements
+  title_content: $ => repeat1($._title_content),
+
+  // Textarea elements contain raw text (but can have character references)
+  // Higher precedence than regular elements to ensure <textarea> is matched first
+  textarea_element: $ => prec(1, seq(
+    $.textarea_start_tag,
+    optional($.textarea_content),
+    $.textarea_end_tag,
+  )),
+
+  textarea_start_tag: $ => seq(
+    '<',
+    alias($._textarea_name, $.element_name),
+    repeat($._html_attribute),
+    '>',
+  ),
+
+  textarea_end_tag: $ => seq(
+    '</',
+    alias($._textarea_name, $.element_name),
+    '>',
+  ),
+
+  // Textarea content is raw text - doesn't contain child elements
+  textarea_content: $ => repeat1($._textarea_content),
+
+  // =========================================================================
+  // HTML Attributes
+  // =========================================================================
+
+  // Note: HTML attribute rules are prefixed with "html_" to avoid collision
+  // with C#'s `attribute` rule (used for [Attribute] syntax)
+
+  _html_attribute: $ => choice(
+    $.html_attribute,
+    $.razor_attribute,
+  ),
+
+  html_attribute: $ => choice(
+    // Attribute with value: name="value" or name = "value"
+    seq(
+      $.html_attribute_name,
+      '=',
+      $.html_attribute_value,
+    ),
+    // Boolean attribute: name (no value)
+    $.html_attribute_name,
+  ),
+
+  // Note: @ is NOT allowed at start - @attributes are handled by razor_attribute
+  html_attribute_name: _ => /[a-zA-Z_:][a-zA-Z0-9_.:-]*/,
+
+  html_attribute_value: $ => choice(
+    $.html_quoted_attribute_value,
+    $.html_unquoted_attribute_value,
+  ),
+
+  html_quoted_attribute_value: $ => choice(
+    seq('"', optional($._html_double_quoted_attribute_content), '"'),
+    seq("'", optional($._html_single_quoted_attribute_content), "'"),
+  ),
+
+  _html_double_quoted_attribute_content: $ => repeat1(choice(
+    /[^"@]+/,
+    // Email/literal @ in attribute values (e.g., mailto:user@example.com)
+    $._text_with_literal_at,
+    $.razor_explicit_expression,
+    $.razor_implicit_expression,
+  )),
+
+  _html_single_quoted_attribute_content: $ => repeat1(choice(
+    /[^'@]+/,
+    // Email/literal @ in attribute values
+    $._text_with_literal_at,
+    $.razor_explicit_expression,
+    $.razor_implicit_expression,
+  )),
+
+  html_unquoted_attribute_value: _ => /[^\s"'=<>`]+/,
+
+  // Razor-specific attribute (e.g., @onclick, @bind)
+  razor_attribute: $ => choice(
+    // With value: @onclick="handler"
+    seq(
+      '@',
+      $.html_attribute_name,
+      '=',
+      $.html_attribute_value,
+    ),
+    // Without value: @rendermode
+    seq('@', $.html_attribute_name),
+  ),
+
+  // =========================================================================
+  // Text Content
+  // =========================================================================
+
+  // Top-level text that can appear between Razor statements
+  // Uses external scanner to stop before else/catch/finally keywords
+  _top_level_text: $ => choice(
+    // Text containing literal @ (email addresses like user@example.com)
+    prec(1, alias($._text_with_literal_at, $.text)),
+    // Main text content - uses external scanner to be keyword-aware
+    alias($._html_text_content, $.text),
+    // Punctuation that could be expression continuations
+    prec(-20, /[.\[(]/),
+  ),
+
+  // Text inside elements - doesn't need to stop at keywords
+  // Also excludes . [ ( which are handled separately for implicit expression chaining
+  text: $ => choice(
+    // Text containing literal @ (email addresses like user@example.com)
+    prec(1, alias($._text_with_literal_at, $.text)),
+    // Regular text content
+    prec(-10, /[^<@.\[(]+/),
+    // Punctuation that could be expression continuations, but parsed as text
+    // when not following an identifier (lower precedence than implicit expressions)
+    prec(-20, /[.\[(]/),
+  ),
+};
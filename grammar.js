@@ -8,18 +8,103 @@
 // @ts-check
 
 const csharp = require("./tree-sitter-c-sharp/grammar");
+const html = require("./common/html");
+
+// C# constructs that can never be parsed inside a Razor document. Pruning them
+// from the inherited rules keeps them out of the generated parse table.
+//
+// - The structured #if rules are dead: the external scanner consumes every
+//   preprocessor line as a single `preproc` extra before they could match.
+// - Namespaces cannot be declared inside @code/@functions or class bodies.
+const PRUNED_CSHARP_MEMBERS = [
+  'preproc_if',
+  'preproc_if_in_top_level',
+  'preproc_if_in_expression',
+  'preproc_if_in_attribute_list',
+  'namespace_declaration',
+];
+
+/**
+ * Removes pruned symbols from an inherited choice() rule, keeping any
+ * precedence wrapped around it
+ *
+ * @param {Rule} rule
+ * @returns {Rule}
+ */
+function pruneCSharpMembers(rule) {
+  switch (rule.type) {
+    case 'PREC':
+    case 'PREC_LEFT':
+    case 'PREC_RIGHT':
+    case 'PREC_DYNAMIC':
+      return {...rule, content: pruneCSharpMembers(rule.content)};
+    case 'CHOICE':
+      return choice(...rule.members.filter(member => {
+        const symbol = member.type === 'ALIAS' ? member.content : member;
+        return !(symbol.type === 'SYMBOL' && PRUNED_CSHARP_MEMBERS.includes(symbol.name));
+      }));
+    default:
+      return rule;
+  }
+}
+
+// Directive names, in the order of RazorKeyword in src/razor_text.h. Each is
+// an external token aliased to '@name', so that a directive never competes
+// with an implicit expression or a C# verbatim identifier in the lexer.
+// @using is left out: without parentheses it is the directive, so it is
+// lexed as '@' and 'using'.
+const DIRECTIVES = [
+  'page',
+  'model',
+  'inject',
+  'inherits',
+  'namespace',
+  'functions',
+  'code',
+  'section',
+  'layout',
+  'attribute',
+  'implements',
+  'typeparam',
+  'preservewhitespace',
+  'rendermode',
+  'addTagHelper',
+  'removeTagHelper',
+  'tagHelperPrefix',
+];
+
+/**
+ * Name of the external token for a directive keyword, e.g.
+ * _addtaghelper_directive_keyword
+ *
+ * @param {string} name
+ * @returns {string}
+ */
+function directiveKeyword(name) {
+  return `_${name.toLowerCase()}_directive_keyword`;
+}
+
+/**
+ * The keyword of a directive, as the '@name' token queries match
+ *
+ * @param {GrammarSymbols<string>} $
+ * @param {string} name
+ * @returns {AliasRule}
+ */
+function directive($, name) {
+  return alias($[directiveKeyword(name)], '@' + name);
+}
 
 module.exports = grammar(csharp, {
   name: "razor",
 
-  conflicts: ($, original) => original.concat([
-    [$._razor_access_chain, $._razor_element_access],
-    [$._razor_access_chain, $._razor_invocation],
-  ]),
-
-  supertypes: ($, original) => original.concat([
-    $.razor_directive,
-  ]),
+  // type_declaration is only reachable through namespace members, which are
+  // pruned (see PRUNED_CSHARP_MEMBERS)
+  supertypes: ($, original) => original
+    .filter(rule => rule.name !== 'type_declaration')
+    .concat([
+      $.razor_directive,
+    ]),
 
   extras: ($, original) => {
     // Replace the individual preproc rules with our unified preproc rule
@@ -52,6 +137,14 @@ module.exports = grammar(csharp, {
     $._style_content,               // Raw content inside <style> tags
     $._title_content,               // Raw content inside <title> tags
     $._textarea_content,            // Raw content inside <textarea> tags
+    // Comments in markup, scanned with a search for the terminator
+    $.razor_comment,                // @* ... *@
+    $.html_comment,                 // <!-- ... -->
+    // '.' continuing an implicit expression, only in front of a member name
+    $._razor_member_dot,
+    // Keywords after @ in markup, read and looked up once by the scanner
+    $._razor_statement_start,       // @ in front of a statement keyword
+    ...DIRECTIVES.map(name => $[directiveKeyword(name)]),
   ]),
 
   rules: {
@@ -68,6 +161,8 @@ module.exports = grammar(csharp, {
       $.textarea_element,
       $.element,
       $.self_closing_element,
+      $.component_element,
+      $.self_closing_component,
       $.void_element,
       $.html_comment,
       $.razor_comment,
@@ -80,52 +175,51 @@ module.exports = grammar(csharp, {
       $._top_level_text,
     ),
 
-    // HTML DOCTYPE declaration
-    // The !DOCTYPE... part must be immediate after < and have higher precedence than opt-out !
-    doctype: $ => seq(
-      '<',
-      token.immediate(prec(10, /![Dd][Oo][Cc][Tt][Yy][Pp][Ee][^>]*/)),
-      '>',
-    ),
-
-    // @@ escapes to a literal @ character
-    escaped_at: _ => '@@',
+    ...html,
 
     // =========================================================================
     // Razor Statements (@if, @foreach, etc.)
     // =========================================================================
 
-    // Razor statement is @ followed by a C# statement
+    // Razor statement is @ followed by a C# statement. The statements are
+    // alternatives of this rule directly, so there is no hidden rule in
+    // between to reduce to.
     razor_statement: $ => seq(
-      '@',
-      $._razor_supported_statement,
-    ),
-
-    _razor_supported_statement: $ => choice(
-      alias($.razor_if_statement, $.if_statement),
-      alias($.razor_for_statement, $.for_statement),
-      alias($.razor_foreach_statement, $.foreach_statement),
-      alias($.razor_while_statement, $.while_statement),
-      alias($.razor_do_statement, $.do_statement),
-      alias($.razor_switch_statement, $.switch_statement),
-      alias($.razor_try_statement, $.try_statement),
-      alias($.razor_lock_statement, $.lock_statement),
-      alias($.razor_using_statement, $.using_statement),
+      alias($._razor_statement_start, '@'),
+      choice(
+        alias($.razor_if_statement, $.if_statement),
+        alias($.razor_for_statement, $.for_statement),
+        alias($.razor_foreach_statement, $.foreach_statement),
+        alias($.razor_while_statement, $.while_statement),
+        alias($.razor_do_statement, $.do_statement),
+        alias($.razor_switch_statement, $.switch_statement),
+        alias($.razor_try_statement, $.try_statement),
+        alias($.razor_lock_statement, $.lock_statement),
+        alias($.razor_using_statement, $.using_statement),
+      ),
     ),
 
     // Razor block - can contain statements AND HTML elements
     // Uses external scanner to track entering/exiting C# context
     razor_block: $ => seq(
       alias($._razor_block_open, '{'),
-      repeat($._razor_block_content),
+      optional($._razor_block_contents),
       alias($._csharp_context_close, '}'),
     ),
 
+    // The contents of statement bodies, @{ } blocks and switch sections. Each
+    // state in a run of them can start any C# statement or element, which
+    // makes them among the largest in the table, so they are built once for
+    // all three rather than once per rule that repeats them.
+    _razor_block_contents: $ => repeat1($._razor_block_content),
+
     // Content inside Razor blocks - can contain C# statements, HTML elements, and Razor expressions
     _razor_block_content: $ => choice(
       $.statement,
       $.element,
       $.self_closing_element,
+      $.component_element,
+      $.self_closing_component,
       $.void_element,
       $.razor_text_literal,
       $.razor_explicit_expression,
@@ -167,9 +261,7 @@ module.exports = grammar(csharp, {
     // Uses prec.right so that else/else if following the block are associated with this if
     razor_if_statement: $ => prec.right(seq(
       'if',
-      '(',
-      field('condition', $.expression),
-      ')',
+      $._razor_condition,
       field('consequence', $.razor_block),
       optional(field('alternative', choice(
         seq('else', alias($.razor_if_statement, $.if_statement)),
@@ -177,6 +269,10 @@ module.exports = grammar(csharp, {
       ))),
     )),
 
+    // Parenthesized condition shared by if/while/do, so the parse states for
+    // the condition are built once rather than once per statement
+    _razor_condition: $ => seq('(', field('condition', $.expression), ')'),
+
     // Else clause (final else in an if chain)
     razor_else_clause: $ => seq(
       'else',
@@ -199,9 +295,7 @@ module.exports = grammar(csharp, {
     // Razor while statement
     razor_while_statement: $ => seq(
       'while',
-      '(',
-      field('condition', $.expression),
-      ')',
+      $._razor_condition,
       field('body', $.razor_block),
     ),
 
@@ -210,9 +304,7 @@ module.exports = grammar(csharp, {
       'do',
       field('body', $.razor_block),
       'while',
-      '(',
-      field('condition', $.expression),
-      ')',
+      $._razor_condition,
       ';',
     ),
 
@@ -239,7 +331,7 @@ module.exports = grammar(csharp, {
         'default',
       ),
       ':',
-      repeat($._razor_block_content),
+      optional($._razor_block_contents),
     )),
 
     // Razor try statement
@@ -277,285 +369,6 @@ module.exports = grammar(csharp, {
       field('body', $.razor_block),
     ),
 
-    // =========================================================================
-    // HTML Elements
-    // =========================================================================
-
-    // Use token.immediate() to ensure no whitespace between < and element name
-    // This prevents "< div>" from being parsed as valid HTML
-
-    // Element content uses _element_content which doesn't stop at else/catch/finally
-    element: $ => seq(
-      $.start_tag,
-      repeat($._element_content),
-      $.end_tag,
-    ),
-
-    // Void elements are HTML elements that cannot have content and must not have an end tag
-    // https://html.spec.whatwg.org/multipage/syntax.html#void-elements
-    // area, base, br, col, embed, hr, img, input, link, meta, source, track, wbr
-    void_element: $ => seq(
-      '<',
-      optional($._tag_helper_opt_out),
-      field('name', alias($._void_element_name, $.element_name)),
-      repeat($._html_attribute),
-      optional('/'),
-      token.immediate('>'),
-    ),
-
-    // Case-insensitive void element names
-    _void_element_name: _ => token.immediate(choice(
-      /area/i,
-      /base/i,
-      /br/i,
-      /col/i,
-      /embed/i,
-      /hr/i,
-      /img/i,
-      /input/i,
-      /link/i,
-      /meta/i,
-      /source/i,
-      /track/i,
-      /wbr/i,
-    )),
-
-    // Content inside elements - doesn't need keyword awareness
-    _element_content: $ => choice(
-      $.script_element,
-      $.style_element,
-      $.title_element,
-      $.textarea_element,
-      $.element,
-      $.self_closing_element,
-      $.void_element,
-      $.html_comment,
-      $.razor_comment,
-      $.razor_directive,
-      $.razor_code_block,
-      $.razor_statement,
-      $.razor_explicit_expression,
-      $.razor_implicit_expression,
-      $.escaped_at,
-      $.text,  // Regular text, not keyword-aware
-    ),
-
-    self_closing_element: $ => seq(
-      '<',
-      optional($._tag_helper_opt_out),
-      field('name', alias($._immediate_element_name, $.element_name)),
-      repeat($._html_attribute),
-      '/',
-      token.immediate('>'),
-    ),
-
-    start_tag: $ => seq(
-      '<',
-      optional($._tag_helper_opt_out),
-      field('name', alias($._immediate_element_name, $.element_name)),
-      repeat($._html_attribute),
-      '>',
-    ),
-
-    end_tag: $ => seq(
-      '</',
-      optional($._tag_helper_opt_out),
-      field('name', alias($._immediate_element_name, $.element_name)),
-      '>',
-    ),
-
-    // Tag Helper opt-out character - must immediately follow < or </
-    _tag_helper_opt_out: _ => token.immediate('!'),
-
-    // Element name that must immediately follow < or </ (or ! if opt-out)
-    _immediate_element_name: _ => token.immediate(/[a-zA-Z][a-zA-Z0-9:-]*/),
-
-    element_name: _ => /[a-zA-Z][a-zA-Z0-9:-]*/,
-
-    // =========================================================================
-    // Script and Style Elements
-    // =========================================================================
-
-    // Script elements contain raw JavaScript content that shouldn't be parsed as HTML
-    // Higher precedence than regular elements to ensure <script> is matched first
-    script_element: $ => prec(1, seq(
-      $.script_start_tag,
-      optional($.script_content),
-      $.script_end_tag,
-    )),
-
-    script_start_tag: $ => seq(
-      '<',
-      alias(token.immediate(prec(1, /script/i)), $.element_name),
-      repeat($._html_attribute),
-      '>',
-    ),
-
-    script_end_tag: $ => seq(
-      '</',
-      alias(token.immediate(prec(1, /script/i)), $.element_name),
-      '>',
-    ),
-
-    script_content: $ => $._script_content,
-
-    // Style elements contain raw CSS content that shouldn't be parsed as HTML
-    // Higher precedence than regular elements to ensure <style> is matched first
-    style_element: $ => prec(1, seq(
-      $.style_start_tag,
-      optional($.style_content),
-      $.style_end_tag,
-    )),
-
-    style_start_tag: $ => seq(
-      '<',
-      alias(token.immediate(prec(1, /style/i)), $.element_name),
-      repeat($._html_attribute),
-      '>',
-    ),
-
-    style_end_tag: $ => seq(
-      '</',
-      alias(token.immediate(prec(1, /style/i)), $.element_name),
-      '>',
-    ),
-
-    style_content: $ => $._style_content,
-
-    // Title elements contain raw text (but can have character references)
-    // Higher precedence than regular elements to ensure <title> is matched first
-    title_element: $ => prec(1, seq(
-      $.title_start_tag,
-      optional($.title_content),
-      $.title_end_tag,
-    )),
-
-    title_start_tag: $ => seq(
-      '<',
-      alias(token.immediate(prec(1, /title/i)), $.element_name),
-      repeat($._html_attribute),
-      '>',
-    ),
-
-    title_end_tag: $ => seq(
-      '</',
-      alias(token.immediate(prec(1, /title/i)), $.element_name),
-      '>',
-    ),
-
-    // Title content is raw text - doesn't contain child elements
-    title_content: $ => $._title_content,
-
-    // Textarea elements contain raw text (but can have character references)
-    // Higher precedence than regular elements to ensure <textarea> is matched first
-    textarea_element: $ => prec(1, seq(
-      $.textarea_start_tag,
-      optional($.textarea_content),
-      $.textarea_end_tag,
-    )),
-
-    textarea_start_tag: $ => seq(
-      '<',
-      alias(token.immediate(prec(1, /textarea/i)), $.element_name),
-      repeat($._html_attribute),
-      '>',
-    ),
-
-    textarea_end_tag: $ => seq(
-      '</',
-      alias(token.immediate(prec(1, /textarea/i)), $.element_name),
-      '>',
-    ),
-
-    // Textarea content is raw text - doesn't contain child elements
-    textarea_content: $ => $._textarea_content,
-
-    // =========================================================================
-    // HTML Attributes
-    // =========================================================================
-
-    // Note: HTML attribute rules are prefixed with "html_" to avoid collision
-    // with C#'s `attribute` rule (used for [Attribute] syntax)
-
-    _html_attribute: $ => choice(
-      $.html_attribute,
-      $.razor_attribute,
-    ),
-
-    html_attribute: $ => choice(
-      // Attribute with value: name="value" or name = "value"
-      seq(
-        $.html_attribute_name,
-        '=',
-        $.html_attribute_value,
-      ),
-      // Boolean attribute: name (no value)
-      $.html_attribute_name,
-    ),
-
-    // Note: @ is NOT allowed at start - @attributes are handled by razor_attribute
-    html_attribute_name: _ => /[a-zA-Z_:][a-zA-Z0-9_.:-]*/,
-
-    html_attribute_value: $ => choice(
-      $.html_quoted_attribute_value,
-      $.html_unquoted_attribute_value,
-    ),
-
-    html_quoted_attribute_value: $ => choice(
-      seq('"', optional($._html_double_quoted_attribute_content), '"'),
-      seq("'", optional($._html_single_quoted_attribute_content), "'"),
-    ),
-
-    _html_double_quoted_attribute_content: $ => repeat1(choice(
-      /[^"@]+/,
-      // Email/literal @ in attribute values (e.g., mailto:user@example.com)
-      $._text_with_literal_at,
-      $.razor_explicit_expression,
-      $.razor_implicit_expression,
-    )),
-
-    _html_single_quoted_attribute_content: $ => repeat1(choice(
-      /[^'@]+/,
-      // Email/literal @ in attribute values
-      $._text_with_literal_at,
-      $.razor_explicit_expression,
-      $.razor_implicit_expression,
-    )),
-
-    html_unquoted_attribute_value: _ => /[^\s"'=<>`]+/,
-
-    // Razor-specific attribute (e.g., @onclick, @bind)
-    razor_attribute: $ => choice(
-      // With value: @onclick="handler"
-      seq(
-        '@',
-        $.html_attribute_name,
-        '=',
-        $.html_attribute_value,
-      ),
-      // Without value: @rendermode
-      seq('@', $.html_attribute_name),
-    ),
-
-    // =========================================================================
-    // Comments
-    // =========================================================================
-
-    // Razor comment @* ... *@
-    // Simple approach: match everything until we see *@
-    razor_comment: $ => token(seq(
-      '@*',
-      /([^*]|\*[^@])*/,
-      '*@',
-    )),
-
-    // HTML comment <!-- ... -->
-    html_comment: $ => token(seq(
-      '<!--',
-      /([^-]|-[^-]|--[^>])*/,
-      '-->',
-    )),
-
     // Override C# comment to use external scanner for context-awareness
     // This ensures comments only match in C# context, not HTML
     comment: $ => $._csharp_comment,
@@ -592,20 +405,20 @@ module.exports = grammar(csharp, {
     ),
 
     // @page takes a route pattern as a string literal
-    razor_page_directive: $ => seq('@page', optional($.string_literal)),
+    razor_page_directive: $ => seq(directive($, 'page'), optional($.string_literal)),
 
-    razor_model_directive: $ => seq('@model', $.type),
+    razor_model_directive: $ => seq(directive($, 'model'), $.type),
 
     // @using directive (imports namespace)
     // The statement form is @using (...) which starts with ( after 'using'
     // The directive form is @using Namespace which has a name after 'using'
     razor_using_directive: $ => prec(1, seq('@', 'using', $._name)),
 
-    razor_inject_directive: $ => seq('@inject', $.type, $.identifier),
+    razor_inject_directive: $ => seq(directive($, 'inject'), $.type, $.identifier),
 
-    razor_inherits_directive: $ => seq('@inherits', $.type),
+    razor_inherits_directive: $ => seq(directive($, 'inherits'), $.type),
 
-    razor_namespace_directive: $ => seq('@namespace', $._name),
+    razor_namespace_directive: $ => seq(directive($, 'namespace'), $._name),
 
     // Override declaration_list to use context-tracking tokens
     // This is used by @functions and @code directives
@@ -615,35 +428,35 @@ module.exports = grammar(csharp, {
       alias($._csharp_context_close, '}'),
     ),
 
-    razor_functions_directive: $ => seq('@functions', $.declaration_list),
+    razor_functions_directive: $ => seq(directive($, 'functions'), $.declaration_list),
 
     // @code is the Blazor equivalent of @functions
-    razor_code_directive: $ => seq('@code', $.declaration_list),
+    razor_code_directive: $ => seq(directive($, 'code'), $.declaration_list),
 
     razor_section_directive: $ => seq(
-      '@section',
+      directive($, 'section'),
       $.identifier,
       '{',
       repeat($._node),
       '}',
     ),
 
-    razor_layout_directive: $ => seq('@layout', $.type),
+    razor_layout_directive: $ => seq(directive($, 'layout'), $.type),
 
-    razor_attribute_directive: $ => seq('@attribute', $.attribute_list),
+    razor_attribute_directive: $ => seq(directive($, 'attribute'), $.attribute_list),
 
-    razor_implements_directive: $ => seq('@implements', $.type),
+    razor_implements_directive: $ => seq(directive($, 'implements'), $.type),
 
-    razor_typeparam_directive: $ => seq('@typeparam', $.identifier, optional($.type_parameter_constraints_clause)),
+    razor_typeparam_directive: $ => seq(directive($, 'typeparam'), $.identifier, optional($.type_parameter_constraints_clause)),
 
-    razor_preservewhitespace_directive: $ => seq('@preservewhitespace', $.boolean_literal),
+    razor_preservewhitespace_directive: $ => seq(directive($, 'preservewhitespace'), $.boolean_literal),
 
-    razor_rendermode_directive: $ => seq('@rendermode', $.expression),
+    razor_rendermode_directive: $ => seq(directive($, 'rendermode'), $.expression),
 
     // @addTagHelper typePattern, assemblyName
     // e.g., @addTagHelper *, Microsoft.AspNetCore.Mvc.TagHelpers
     razor_addtaghelper_directive: $ => seq(
-      '@addTagHelper',
+      directive($, 'addTagHelper'),
       field('type_pattern', $.tag_helper_type_pattern),
       ',',
       field('assembly', $._name),
@@ -651,7 +464,7 @@ module.exports = grammar(csharp, {
 
     // @removeTagHelper typePattern, assemblyName
     razor_removetaghelper_directive: $ => seq(
-      '@removeTagHelper',
+      directive($, 'removeTagHelper'),
       field('type_pattern', $.tag_helper_type_pattern),
       ',',
       field('assembly', $._name),
@@ -660,7 +473,7 @@ module.exports = grammar(csharp, {
     // @tagHelperPrefix prefix
     // e.g., @tagHelperPrefix th:
     razor_taghelperprefix_directive: $ => seq(
-      '@tagHelperPrefix',
+      directive($, 'tagHelperPrefix'),
       field('prefix', $.tag_helper_prefix),
     ),
 
@@ -681,7 +494,7 @@ module.exports = grammar(csharp, {
     // Uses external scanner to track entering/exiting C# context
     razor_code_block: $ => prec.dynamic(100, seq(
       alias($._csharp_code_block_start, '@{'),
-      repeat($._razor_block_content),
+      optional($._razor_block_contents),
       alias($._csharp_context_close, '}'),
     )),
 
@@ -729,31 +542,45 @@ module.exports = grammar(csharp, {
 
     // Primary expression that can have member access, invocation, or indexing applied
     // Uses prec.left for left-to-right associativity (foo.bar.baz groups as ((foo.bar).baz))
+    //
+    // As in Razor, the chain only continues with no whitespace in between,
+    // and a '.' only continues it in front of a member name. The tokens that
+    // continue it are therefore never the ones that could start the next
+    // statement in a block (`@items [0]`, `@Run (x)`) or text after it
+    // (`@Model.Name.`), and the parser decides with one token of lookahead
+    // instead of keeping a version for each reading alive.
     _razor_primary_expression: $ => choice(
-      prec.dynamic(1, $.identifier),
-      prec.dynamic(20, alias($._razor_member_access, $.member_access_expression)),
-      prec.dynamic(20, alias($._razor_invocation, $.invocation_expression)),
-      prec.dynamic(20, alias($._razor_element_access, $.element_access_expression)),
-      prec.dynamic(20, alias($._razor_conditional_access, $.conditional_access_expression)),
+      $.identifier,
+      alias($._razor_member_access, $.member_access_expression),
+      alias($._razor_invocation, $.invocation_expression),
+      alias($._razor_element_access, $.element_access_expression),
+      alias($._razor_conditional_access, $.conditional_access_expression),
     ),
 
     // Member access: expr.identifier
     _razor_member_access: $ => prec.left(seq(
       field('expression', $._razor_primary_expression),
-      '.',
+      alias($._razor_member_dot, '.'),
       field('name', $.identifier),
     )),
 
     // Invocation: expr(args) or expr.method(args)
     _razor_invocation: $ => prec.left(seq(
       field('function', $._razor_primary_expression),
-      field('arguments', $.argument_list),
+      field('arguments', alias($._razor_argument_list, $.argument_list)),
     )),
 
+    // The C# argument_list, opened right after the expression
+    _razor_argument_list: $ => seq(
+      token.immediate(prec(1, '(')),
+      optional(seq($.argument, repeat(seq(',', $.argument)))),
+      ')',
+    ),
+
     // Element access: expr[index]
     _razor_element_access: $ => prec.left(seq(
       field('expression', $._razor_primary_expression),
-      '[',
+      token.immediate(prec(1, '[')),
       field('subscript', $.expression),
       ']',
     )),
@@ -761,7 +588,7 @@ module.exports = grammar(csharp, {
     // Conditional access: expr?.identifier
     _razor_conditional_access: $ => prec.left(seq(
       field('expression', $._razor_primary_expression),
-      '?.',
+      token.immediate(prec(1, '?.')),
       field('name', $.identifier),
     )),
 
@@ -774,12 +601,12 @@ module.exports = grammar(csharp, {
     // Example: RenderFragment template = @<p>Hello @item</p>;
     razor_fragment: $ => seq(
       '@',
-      choice($.element, $.self_closing_element),
+      choice($.element, $.self_closing_element, $.component_element, $.self_closing_component),
     ),
 
     // Extend expression to include razor_fragment
     non_lvalue_expression: ($, original) => choice(
-      original,
+      pruneCSharpMembers(original),
       $.razor_fragment,
     ),
 
@@ -791,6 +618,8 @@ module.exports = grammar(csharp, {
         $.statement,
         $.element,
         $.self_closing_element,
+        $.component_element,
+        $.self_closing_component,
         $.void_element,
         $.razor_text_literal,
       )),
@@ -798,30 +627,24 @@ module.exports = grammar(csharp, {
     ),
 
     // =========================================================================
-    // Text Content
+    // Pruned C# rules (see PRUNED_CSHARP_MEMBERS)
     // =========================================================================
 
-    // Top-level text that can appear between Razor statements
-    // Uses external scanner to stop before else/catch/finally keywords
-    _top_level_text: $ => choice(
-      // Text containing literal @ (email addresses like user@example.com)
-      prec(1, alias($._text_with_literal_at, $.text)),
-      // Main text content - uses external scanner to be keyword-aware
-      alias($._html_text_content, $.text),
-      // Punctuation that could be expression continuations
-      prec(-20, /[.\[(]/),
-    ),
+    declaration: ($, original) => pruneCSharpMembers(original),
+
+    statement: ($, original) => pruneCSharpMembers(original),
 
-    // Text inside elements - doesn't need to stop at keywords
-    // Also excludes . [ ( which are handled separately for implicit expression chaining
-    text: $ => choice(
-      // Text containing literal @ (email addresses like user@example.com)
-      prec(1, alias($._text_with_literal_at, $.text)),
-      // Regular text content
-      prec(-10, /[^<@.\[(]+/),
-      // Punctuation that could be expression continuations, but parsed as text
-      // when not following an identifier (lower precedence than implicit expressions)
-      prec(-20, /[.\[(]/),
+    _attribute_list: ($, original) => pruneCSharpMembers(original),
+
+    // Same as the C# rule without the preproc_if alternative for members
+    enum_member_declaration_list: $ => seq(
+      '{',
+      optional(seq(
+        $.enum_member_declaration,
+        repeat(seq(',', $.enum_member_declaration)),
+      )),
+      optional(','),
+      '}',
     ),
 
   },
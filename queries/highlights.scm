@@ -0,0 +1,215 @@
+; Patterns are kept to plain node and field matches: no #match? predicates
+; and no captures on every identifier or text node. Earlier patterns take
+; precedence, so specific C# patterns come before the generic fallbacks.
+
+; Razor transitions
+(razor_code_block
+  [
+    "@{"
+    "}"
+  ] @punctuation.special)
+
+(razor_explicit_expression
+  [
+    "@("
+    ")"
+  ] @punctuation.special)
+
+(razor_implicit_expression
+  "@" @punctuation.special)
+
+(razor_statement
+  "@" @punctuation.special)
+
+(razor_fragment
+  "@" @punctuation.special)
+
+(razor_text_literal
+  "@:" @punctuation.special)
+
+(razor_attribute
+  "@" @punctuation.special)
+
+(escaped_at) @string.escape
+
+; Directives
+[
+  "@page"
+  "@model"
+  "@inject"
+  "@inherits"
+  "@namespace"
+  "@functions"
+  "@code"
+  "@section"
+  "@layout"
+  "@attribute"
+  "@implements"
+  "@typeparam"
+  "@preservewhitespace"
+  "@rendermode"
+  "@addTagHelper"
+  "@removeTagHelper"
+  "@tagHelperPrefix"
+] @keyword.directive
+
+(razor_using_directive
+  [
+    "@"
+    "using"
+  ] @keyword.directive)
+
+(razor_section_directive
+  "@section"
+  .
+  (identifier) @label)
+
+(razor_inject_directive
+  (identifier) @property .)
+
+(tag_helper_prefix) @string.special
+
+; Comments
+[
+  (razor_comment)
+  (html_comment)
+  (comment)
+] @comment
+
+(preproc) @keyword.directive
+
+; HTML
+(doctype) @constant
+
+(element_name) @tag
+
+(component_name) @type
+
+(html_attribute_name) @attribute
+
+[
+  (html_quoted_attribute_value)
+  (html_unquoted_attribute_value)
+] @string
+
+(title_content) @markup.heading
+
+(textarea_content) @string
+
+[
+  "<"
+  ">"
+  "</"
+  "/"
+] @punctuation.bracket
+
+"=" @operator
+
+; Razor control flow
+(if_statement
+  [
+    "if"
+    "else"
+  ] @keyword.conditional)
+
+(else_clause
+  "else" @keyword.conditional)
+
+(switch_statement
+  "switch" @keyword.conditional)
+
+(razor_switch_section
+  [
+    "case"
+    "default"
+  ] @keyword.conditional)
+
+[
+  "for"
+  "foreach"
+  "in"
+  "while"
+  "do"
+] @keyword.repeat
+
+[
+  "try"
+  "catch"
+  "finally"
+] @keyword.exception
+
+[
+  "lock"
+  "using"
+  "await"
+  "return"
+  "var"
+  "new"
+] @keyword
+
+; C# declarations
+(class_declaration
+  name: (identifier) @type)
+
+(interface_declaration
+  name: (identifier) @type)
+
+(struct_declaration
+  name: (identifier) @type)
+
+(record_declaration
+  name: (identifier) @type)
+
+(enum_declaration
+  name: (identifier) @type)
+
+(method_declaration
+  name: (identifier) @function.method)
+
+(local_function_statement
+  name: (identifier) @function)
+
+(property_declaration
+  name: (identifier) @property)
+
+(parameter
+  name: (identifier) @variable.parameter)
+
+(variable_declarator
+  name: (identifier) @variable)
+
+; C# calls and member access
+(invocation_expression
+  function: (member_access_expression
+    name: (identifier) @function.method.call))
+
+(invocation_expression
+  function: (identifier) @function.call)
+
+(member_access_expression
+  name: (identifier) @property)
+
+; C# types and literals
+(predefined_type) @type.builtin
+
+(implicit_type) @type.builtin
+
+(modifier) @keyword.modifier
+
+[
+  (string_literal)
+  (verbatim_string_literal)
+  (raw_string_literal)
+  (interpolated_string_expression)
+] @string
+
+(character_literal) @character
+
+[
+  (integer_literal)
+  (real_literal)
+] @number
+
+(boolean_literal) @boolean
+
+(null_literal) @constant.builtin
@@ -1,9 +1,60 @@
-; Inject JavaScript into script elements
+; Script and style blocks are injected only when their `type` says they hold
+; JavaScript, JSON or CSS. Blocks of any other type (text/template,
+; text/x-handlebars-template, ...) are left alone, so hosts never run a second
+; parser over them. The predicates only look at the start tag, never at the
+; block itself.
+;
+; HTML matches attribute names and these types in any case
+; (type="Text/JavaScript"). The patterns spell that out with a class per
+; letter rather than (?i), which not every host's regex engine takes.
+;
+; There is no size limit in the patterns: hosts that defer or skip large
+; blocks can compare the byte range of @injection.content against their own
+; budget, which costs nothing since it is stored on the node.
+
+; Inject JavaScript into script elements with no type
+((script_element
+  (script_start_tag) @_tag
+  (script_content) @injection.content)
+  (#not-match? @_tag "\\s[tT][yY][pP][eE]\\s*=")
+  (#set! injection.language "javascript"))
+
+; Inject JavaScript into script elements with a JavaScript type
 ((script_element
+  (script_start_tag
+    (html_attribute
+      (html_attribute_name) @_name
+      (html_attribute_value) @_type))
   (script_content) @injection.content)
+  (#match? @_name "^[tT][yY][pP][eE]$")
+  (#match? @_type "^[\"']?([tT][eE][xX][tT]/[jJ][aA][vV][aA][sS][cC][rR][iI][pP][tT]|[aA][pP][pP][lL][iI][cC][aA][tT][iI][oO][nN]/[jJ][aA][vV][aA][sS][cC][rR][iI][pP][tT]|[tT][eE][xX][tT]/[eE][cC][mM][aA][sS][cC][rR][iI][pP][tT]|[aA][pP][pP][lL][iI][cC][aA][tT][iI][oO][nN]/[eE][cC][mM][aA][sS][cC][rR][iI][pP][tT]|[mM][oO][dD][uU][lL][eE])[\"']?$")
   (#set! injection.language "javascript"))
 
-; Inject CSS into style elements
+; Inject JSON into import maps, speculation rules and JSON data blocks
+((script_element
+  (script_start_tag
+    (html_attribute
+      (html_attribute_name) @_name
+      (html_attribute_value) @_type))
+  (script_content) @injection.content)
+  (#match? @_name "^[tT][yY][pP][eE]$")
+  (#match? @_type "^[\"']?([aA][pP][pP][lL][iI][cC][aA][tT][iI][oO][nN]/[jJ][sS][oO][nN]|[aA][pP][pP][lL][iI][cC][aA][tT][iI][oO][nN]/[lL][dD]\\+[jJ][sS][oO][nN]|[iI][mM][pP][oO][rR][tT][mM][aA][pP]|[sS][pP][eE][cC][uU][lL][aA][tT][iI][oO][nN][rR][uU][lL][eE][sS])[\"']?$")
+  (#set! injection.language "json"))
+
+; Inject CSS into style elements with no type
+((style_element
+  (style_start_tag) @_tag
+  (style_content) @injection.content)
+  (#not-match? @_tag "\\s[tT][yY][pP][eE]\\s*=")
+  (#set! injection.language "css"))
+
+; Inject CSS into style elements with a CSS type
 ((style_element
+  (style_start_tag
+    (html_attribute
+      (html_attribute_name) @_name
+      (html_attribute_value) @_type))
   (style_content) @injection.content)
+  (#match? @_name "^[tT][yY][pP][eE]$")
+  (#match? @_type "^[\"']?[tT][eE][xX][tT]/[cC][sS][sS][\"']?$")
   (#set! injection.language "css"))
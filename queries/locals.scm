@@ -0,0 +1,35 @@
+; Scopes
+[
+  (razor_code_block)
+  (razor_functions_directive)
+  (razor_code_directive)
+  (block)
+  (method_declaration)
+  (local_function_statement)
+  (lambda_expression)
+  (for_statement)
+  (foreach_statement)
+  (catch_clause)
+] @local.scope
+
+; Definitions
+(variable_declarator
+  name: (identifier) @local.definition.var)
+
+(parameter
+  name: (identifier) @local.definition.parameter)
+
+(foreach_statement
+  left: (identifier) @local.definition.var)
+
+(catch_declaration
+  name: (identifier) @local.definition.var)
+
+(local_function_statement
+  name: (identifier) @local.definition.function)
+
+(razor_inject_directive
+  (identifier) @local.definition.var .)
+
+; References
+(identifier) @local.reference
@@ -0,0 +1,48 @@
+(class_declaration
+  name: (identifier) @name) @definition.class
+
+(record_declaration
+  name: (identifier) @name) @definition.class
+
+(struct_declaration
+  name: (identifier) @name) @definition.class
+
+(interface_declaration
+  name: (identifier) @name) @definition.interface
+
+(enum_declaration
+  name: (identifier) @name) @definition.enum
+
+(method_declaration
+  name: (identifier) @name) @definition.method
+
+(local_function_statement
+  name: (identifier) @name) @definition.function
+
+(property_declaration
+  name: (identifier) @name) @definition.property
+
+(razor_section_directive
+  "@section"
+  .
+  (identifier) @name) @definition.section
+
+(razor_inject_directive
+  (identifier) @name .) @definition.property
+
+(invocation_expression
+  function: (member_access_expression
+    name: (identifier) @name)) @reference.call
+
+(invocation_expression
+  function: (identifier) @name) @reference.call
+
+(object_creation_expression
+  type: (identifier) @name) @reference.class
+
+(component_element
+  (start_tag
+    name: (component_name) @name)) @reference.class
+
+(self_closing_component
+  name: (component_name) @name) @reference.class
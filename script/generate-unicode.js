@@ -0,0 +1,95 @@
+#!/usr/bin/env node
+
+/**
+ * Generates src/unicode.h, the word-character table used by the external
+ * scanner for email and keyword boundary detection.
+ *
+ * A word character is a letter or decimal digit, matching .NET's
+ * char.IsLetter || char.IsDigit (categories Lu, Ll, Lt, Lm, Lo and Nd). The
+ * table is two-level: code points are split into blocks of 128, identical
+ * blocks are stored once as a bitmap, and an index maps each block to its
+ * bitmap. Blocks past the end of the index contain no word characters.
+ *
+ * Category data comes from the Unicode version built into Node.js.
+ *
+ * Usage: node script/generate-unicode.js > src/unicode.h
+ */
+
+const BLOCK_SIZE = 128;
+const WORDS_PER_BLOCK = BLOCK_SIZE / 32;
+const MAX_CODE_POINT = 0x10FFFF;
+
+const WORD_CHAR = /[\p{Lu}\p{Ll}\p{Lt}\p{Lm}\p{Lo}\p{Nd}]/u;
+
+function isWordChar(c) {
+  return !(c >= 0xD800 && c <= 0xDFFF) && WORD_CHAR.test(String.fromCodePoint(c));
+}
+
+const blocks = [];
+const blockIds = new Map();
+const index = [];
+
+for (let start = 0; start <= MAX_CODE_POINT; start += BLOCK_SIZE) {
+  const words = new Uint32Array(WORDS_PER_BLOCK);
+  for (let c = start; c < start + BLOCK_SIZE; c++) {
+    if (isWordChar(c)) {
+      words[(c - start) >> 5] |= 1 << ((c - start) & 31);
+    }
+  }
+  const key = words.join(',');
+  if (!blockIds.has(key)) {
+    blockIds.set(key, blocks.length);
+    blocks.push(words);
+  }
+  index.push(blockIds.get(key));
+}
+
+// Trailing empty blocks are implied by the index length
+const emptyBlock = blockIds.get(new Uint32Array(WORDS_PER_BLOCK).join(','));
+while (index.length > 0 && index[index.length - 1] === emptyBlock) {
+  index.pop();
+}
+
+if (blocks.length > 256) {
+  throw new Error(`${blocks.length} distinct blocks do not fit a uint8_t index`);
+}
+
+const hex = (value, width) => `0x${value.toString(16).toUpperCase().padStart(width, '0')}`;
+
+const lines = [];
+lines.push('// Generated by script/generate-unicode.js - do not edit by hand.');
+lines.push(`// Unicode ${process.versions.unicode}: Lu, Ll, Lt, Lm, Lo, Nd`);
+lines.push('');
+lines.push('#ifndef TREE_SITTER_RAZOR_UNICODE_H_');
+lines.push('#define TREE_SITTER_RAZOR_UNICODE_H_');
+lines.push('');
+lines.push('#include <stdbool.h>');
+lines.push('#include <stdint.h>');
+lines.push('');
+lines.push(`#define UNICODE_WORD_BLOCK_SHIFT 7`);
+lines.push(`#define UNICODE_WORD_BLOCK_COUNT ${index.length}`);
+lines.push('');
+lines.push(`static const uint8_t UNICODE_WORD_INDEX[UNICODE_WORD_BLOCK_COUNT] = {`);
+for (let i = 0; i < index.length; i += 16) {
+  lines.push(`    ${index.slice(i, i + 16).map((id) => `${id},`).join(' ')}`);
+}
+lines.push('};');
+lines.push('');
+lines.push(`static const uint32_t UNICODE_WORD_BITS[${blocks.length}][${WORDS_PER_BLOCK}] = {`);
+for (const words of blocks) {
+  lines.push(`    {${Array.from(words, (word) => hex(word, 8)).join(', ')}},`);
+}
+lines.push('};');
+lines.push('');
+lines.push('// Whether c is a letter or decimal digit');
+lines.push('static inline bool unicode_is_word_char(int32_t c) {');
+lines.push('    if (c < 0 || (c >> UNICODE_WORD_BLOCK_SHIFT) >= UNICODE_WORD_BLOCK_COUNT) {');
+lines.push('        return false;');
+lines.push('    }');
+lines.push('    const uint32_t *block = UNICODE_WORD_BITS[UNICODE_WORD_INDEX[c >> UNICODE_WORD_BLOCK_SHIFT]];');
+lines.push('    return (block[(c >> 5) & 3] >> (c & 31)) & 1;');
+lines.push('}');
+lines.push('');
+lines.push('#endif // TREE_SITTER_RAZOR_UNICODE_H_');
+
+process.stdout.write(lines.join('\n') + '\n');
@@ -1,4 +1,4 @@
-from os import path
+from os import environ, path
 from sysconfig import get_config_var
 
 from setuptools import Extension, find_packages, setup
@@ -16,6 +16,12 @@ class Build(build):
         super().run()
 
 
+def setting(name: str):
+    """An optimized build setting, named as for make and CMake."""
+    value = environ.get(name, "")
+    return value if value not in ("", "0") else None
+
+
 class BuildExt(build_ext):
     def build_extension(self, ext: Extension):
         if self.compiler.compiler_type != "msvc":
@@ -26,8 +32,39 @@ class BuildExt(build_ext):
             ext.sources.append("src/scanner.c")
         if ext.py_limited_api:
             ext.define_macros.append(("Py_LIMITED_API", "0x030A0000"))
+        self.optimize(ext)
         super().build_extension(ext)
 
+    def optimize(self, ext: Extension):
+        """Apply TREE_SITTER_RAZOR_LTO, TREE_SITTER_RAZOR_PGO_USE (a Clang
+        profile from `make pgo`) and TREE_SITTER_RAZOR_PARSER_OPT."""
+        if self.compiler.compiler_type == "msvc":
+            if setting("TREE_SITTER_RAZOR_LTO"):
+                ext.extra_compile_args.append("/GL")
+                ext.extra_link_args.append("/LTCG")
+            return
+        if setting("TREE_SITTER_RAZOR_LTO"):
+            ext.extra_compile_args.append("-flto")
+            ext.extra_link_args.append("-flto")
+        profile = setting("TREE_SITTER_RAZOR_PGO_USE")
+        if profile:
+            # GCC profiles are tied to the objects that wrote them
+            if "clang" in path.basename(self.compiler.compiler[0]):
+                ext.extra_compile_args.append(f"-fprofile-use={profile}")
+            else:
+                self.warn("TREE_SITTER_RAZOR_PGO_USE needs a Clang compiler; building without the profile")
+        parser_opt = setting("TREE_SITTER_RAZOR_PARSER_OPT")
+        if parser_opt and "src/parser.c" in ext.sources:
+            # Flags given after the ones Python was built with take precedence
+            ext.sources.remove("src/parser.c")
+            ext.extra_objects += self.compiler.compile(
+                ["src/parser.c"],
+                output_dir=self.build_temp,
+                macros=ext.define_macros,
+                include_dirs=ext.include_dirs,
+                extra_postargs=[*ext.extra_compile_args, parser_opt],
+            )
+
 
 class BdistWheel(bdist_wheel):
     def get_tag(self):
@@ -41,6 +78,7 @@ class EggInfo(egg_info):
     def find_sources(self):
         super().find_sources()
         self.filelist.recursive_include("queries", "*.scm")
+        self.filelist.include("src/*.h")
         self.filelist.include("src/tree_sitter/*.h")
 
 
@@ -0,0 +1,191 @@
+/**
+ * @file Razor grammar for Tree-sitter with C# left to an injected parser
+ * @author Jeffrey Crochet <jlcrochet91@pm.me>
+ * @license MIT
+ *
+ * The same markup as the full grammar, but every C# region is a single
+ * `csharp_code` token produced by the external scanner: the bodies of @{ },
+ * @( ), @code and @functions, implicit expressions, @if/@foreach/...
+ * statements (one token for each stretch of C# between the markup in their
+ * blocks) and directive arguments. None of the C# grammar is inherited,
+ * so the parse table is a small fraction of the full one. Hosts that need
+ * the C# can parse the regions lazily through queries/injections.scm.
+ */
+
+/// <reference types="tree-sitter-cli/dsl" />
+// @ts-check
+
+const html = require("../common/html");
+
+// Directives whose argument is the rest of the line
+const LINE_DIRECTIVES = [
+  'page',
+  'model',
+  'using',
+  'inject',
+  'inherits',
+  'namespace',
+  'layout',
+  'attribute',
+  'implements',
+  'typeparam',
+  'preservewhitespace',
+  'rendermode',
+  'addTagHelper',
+  'removeTagHelper',
+  'tagHelperPrefix',
+];
+
+module.exports = grammar({
+  name: "razor_split",
+
+  extras: _ => [/[\s\u00A0\uFEFF\u3000]+/],
+
+  supertypes: $ => [
+    $.razor_directive,
+  ],
+
+  externals: $ => [
+    $._text_with_literal_at,
+    $._html_text_content,
+    $._script_content,
+    $._style_content,
+    $._title_content,
+    $._textarea_content,
+    // C# regions (see split/src/scanner.c)
+    $._razor_statement_start,         // @ in front of a statement keyword
+    $._csharp_statement,              // if (...) { ... } else { ... }
+    $._csharp_implicit_expression,    // Model.Items[0].Name
+    $._csharp_braced_content,         // Body of @{ } and @code { }
+    $._csharp_parenthesized_content,  // Body of @( )
+    $._csharp_directive_argument,     // Rest of the line after a directive
+    // Comments in markup (see src/razor_text.h)
+    $.razor_comment,                  // @* ... *@
+    $.html_comment,                   // <!-- ... -->
+    // Statements with markup in their blocks
+    $._csharp_statement_head,         // if (...) { up to the first markup
+    $._csharp_statement_body,         // } else { between two runs of markup
+    $._csharp_statement_tail,         // } after the last markup
+  ],
+
+  rules: {
+    compilation_unit: $ => repeat($._node),
+
+    _node: $ => choice(
+      $.doctype,
+      $.script_element,
+      $.style_element,
+      $.title_element,
+      $.textarea_element,
+      $.element,
+      $.self_closing_element,
+      $.component_element,
+      $.self_closing_component,
+      $.void_element,
+      $.html_comment,
+      $.razor_comment,
+      $.razor_directive,
+      $.razor_code_block,
+      $.razor_statement,
+      $.razor_explicit_expression,
+      $.razor_implicit_expression,
+      $.escaped_at,
+      $._top_level_text,
+    ),
+
+    ...html,
+
+    // =========================================================================
+    // Razor transitions
+    // =========================================================================
+
+    // The C# is split around the markup in the blocks, so each csharp_code
+    // holds C# only. The scanner tells a statement that ends before any
+    // markup from one that stops at it, so its markup is never confused
+    // with the siblings after it.
+    razor_statement: $ => seq(
+      alias($._razor_statement_start, '@'),
+      choice(
+        alias($._csharp_statement, $.csharp_code),
+        seq(
+          alias($._csharp_statement_head, $.csharp_code),
+          repeat1($._statement_markup),
+          repeat(seq(
+            alias($._csharp_statement_body, $.csharp_code),
+            repeat1($._statement_markup),
+          )),
+          alias($._csharp_statement_tail, $.csharp_code),
+        ),
+      ),
+    ),
+
+    // Markup that starts a C# statement in a block
+    _statement_markup: $ => choice(
+      $.script_element,
+      $.style_element,
+      $.title_element,
+      $.textarea_element,
+      $.element,
+      $.self_closing_element,
+      $.component_element,
+      $.self_closing_component,
+      $.void_element,
+      $.html_comment,
+    ),
+
+    razor_code_block: $ => seq(
+      '@{',
+      optional(alias($._csharp_braced_content, $.csharp_code)),
+      '}',
+    ),
+
+    razor_explicit_expression: $ => seq(
+      '@(',
+      optional(alias($._csharp_parenthesized_content, $.csharp_code)),
+      ')',
+    ),
+
+    razor_implicit_expression: $ => seq(
+      '@',
+      alias($._csharp_implicit_expression, $.csharp_code),
+    ),
+
+    // =========================================================================
+    // Razor directives
+    // =========================================================================
+
+    razor_directive: $ => choice(
+      $.razor_line_directive,
+      $.razor_functions_directive,
+      $.razor_code_directive,
+      $.razor_section_directive,
+    ),
+
+    // @page "/route", @model Foo, @inject IFoo Foo, ... The directive name is
+    // its keyword token, so queries tell them apart by "@page" and so on.
+    razor_line_directive: $ => seq(
+      choice(...LINE_DIRECTIVES.map(name => '@' + name)),
+      optional(alias($._csharp_directive_argument, $.csharp_code)),
+    ),
+
+    razor_functions_directive: $ => seq('@functions', $._csharp_member_block),
+
+    razor_code_directive: $ => seq('@code', $._csharp_member_block),
+
+    _csharp_member_block: $ => seq(
+      '{',
+      optional(alias($._csharp_braced_content, $.csharp_code)),
+      '}',
+    ),
+
+    razor_section_directive: $ => seq(
+      '@section',
+      field('name', $.identifier),
+      '{',
+      repeat($._node),
+      '}',
+    ),
+
+    identifier: _ => /[a-zA-Z_][a-zA-Z0-9_]*/,
+  },
+});
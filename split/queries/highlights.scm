@@ -0,0 +1,71 @@
+; Markup only: the C# in csharp_code nodes is highlighted by the injected
+; C# grammar (see injections.scm).
+
+[
+  "@"
+  "@{"
+  "@("
+] @punctuation.special
+
+(razor_code_block
+  "}" @punctuation.special)
+
+(razor_explicit_expression
+  ")" @punctuation.special)
+
+(escaped_at) @string.escape
+
+(razor_line_directive
+  [
+    "@page"
+    "@model"
+    "@using"
+    "@inject"
+    "@inherits"
+    "@namespace"
+    "@layout"
+    "@attribute"
+    "@implements"
+    "@typeparam"
+    "@preservewhitespace"
+    "@rendermode"
+    "@addTagHelper"
+    "@removeTagHelper"
+    "@tagHelperPrefix"
+  ] @keyword.directive)
+
+[
+  "@functions"
+  "@code"
+  "@section"
+] @keyword.directive
+
+(razor_section_directive
+  name: (identifier) @label)
+
+[
+  (razor_comment)
+  (html_comment)
+] @comment
+
+(doctype) @constant
+
+(element_name) @tag
+
+(component_name) @type
+
+(html_attribute_name) @attribute
+
+[
+  (html_quoted_attribute_value)
+  (html_unquoted_attribute_value)
+] @string
+
+[
+  "<"
+  ">"
+  "</"
+  "/"
+] @punctuation.bracket
+
+"=" @operator
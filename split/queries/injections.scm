@@ -0,0 +1,21 @@
+; Each C# region is its own csharp_code node, so hosts can parse them one at
+; a time and only when needed, e.g. just the regions in view. Script and
+; style blocks use the same rules as the full grammar (queries/injections.scm).
+([
+  (razor_code_block (csharp_code) @injection.content)
+  (razor_explicit_expression (csharp_code) @injection.content)
+  (razor_implicit_expression (csharp_code) @injection.content)
+  (razor_line_directive (csharp_code) @injection.content)
+  (razor_code_directive (csharp_code) @injection.content)
+  (razor_functions_directive (csharp_code) @injection.content)
+]
+  (#set! injection.language "c_sharp"))
+
+; A statement is split around the markup in its blocks, so its csharp_code
+; nodes are only C# together: `if (x) {` and `}` around an element. Each
+; stretch is balanced once its markup is gone, so combining them gives the
+; statements in order.
+((razor_statement
+  (csharp_code) @injection.content)
+  (#set! injection.language "c_sharp")
+  (#set! injection.combined))
@@ -0,0 +1,682 @@
+/**
+ * Razor external scanner for the split grammar
+ *
+ * The split grammar leaves C# to an injected parser, so every C# region is
+ * a single opaque token here: the body of @{ } and @( ), the body of
+ * @code/@functions, an implicit expression, an @if/@foreach/... statement
+ * and the argument of a line directive. Regions are delimited by balancing
+ * brackets, skipping over C# strings, character literals and comments so the
+ * brackets inside those do not count.
+ *
+ * Markup in the blocks of a statement is left to the grammar, so a statement
+ * is split into C# segments around it: `if (x) {`, the element, then `}`.
+ * The statements waiting for the segment after their markup are the only
+ * state kept between tokens.
+ *
+ * The HTML text and raw text tokens are shared with the full scanner through
+ * razor_text.h.
+ */
+
+#include "tree_sitter/alloc.h"
+#include "tree_sitter/parser.h"
+
+#include "../../src/razor_text.h"
+
+enum TokenType {
+    TEXT_WITH_LITERAL_AT,
+    HTML_TEXT_CONTENT,
+    SCRIPT_CONTENT,
+    STYLE_CONTENT,
+    TITLE_CONTENT,
+    TEXTAREA_CONTENT,
+    RAZOR_STATEMENT_START,       // '@' in front of a statement keyword
+    CSHARP_STATEMENT,            // @if (...) { } else { } and the like, after the '@'
+    CSHARP_IMPLICIT_EXPRESSION,  // Model.Items[0].Name after an '@'
+    CSHARP_BRACED_CONTENT,       // Everything up to the '}' closing @{ or @code {
+    CSHARP_PARENTHESIZED_CONTENT,  // Everything up to the ')' closing @(
+    CSHARP_DIRECTIVE_ARGUMENT,   // Rest of the line after @model, @inject, ...
+    RAZOR_COMMENT,               // @* ... *@
+    HTML_COMMENT,                // <!-- ... -->
+    CSHARP_STATEMENT_HEAD,       // A statement up to the first markup in its blocks
+    CSHARP_STATEMENT_BODY,       // C# between two runs of markup in a statement
+    CSHARP_STATEMENT_TAIL,       // C# after the last markup, to the end of the statement
+};
+
+// The statement keywords that decide which clauses may follow a block
+typedef enum {
+    STATEMENT_OTHER,
+    STATEMENT_IF,   // if, else
+    STATEMENT_TRY,  // try, catch, finally
+    STATEMENT_DO,
+} StatementKind;
+
+// A statement stopped at markup is kept in one byte: its kind in the top two
+// bits and the number of braces open in it in the rest
+#define STATEMENT_KIND_SHIFT 6
+#define STATEMENT_MAX_DEPTH 0x3F
+#define STATEMENT_STACK_CAPACITY 32
+
+typedef struct {
+    // Statements stopped at markup, innermost last
+    uint8_t statements[STATEMENT_STACK_CAPACITY];
+    uint8_t statement_count;
+} SplitScanner;
+
+// =============================================================================
+// C# regions
+// =============================================================================
+
+static inline bool is_inline_space(int32_t c) {
+    return c == ' ' || c == '\t';
+}
+
+// Read an identifier into buffer, truncating it; returns the full length
+static unsigned read_identifier(TSLexer *lexer, char *buffer, unsigned size) {
+    unsigned length = 0;
+    while (is_identifier_char(lexer->lookahead)) {
+        if (length + 1 < size) {
+            buffer[length] = lexer->lookahead < 0x80 ? (char)lexer->lookahead : '\x7F';
+        }
+        length++;
+        razor_advance(lexer);
+    }
+    buffer[length + 1 < size ? length : size - 1] = '\0';
+    return length;
+}
+
+// Consume up to and including the next run of `quotes` double quotes
+static void skip_raw_string_body(TSLexer *lexer, unsigned quotes) {
+    unsigned run = 0;
+    while (!lexer->eof(lexer) && run < quotes) {
+        run = lexer->lookahead == '"' ? run + 1 : 0;
+        razor_advance(lexer);
+    }
+}
+
+// Consume a string whose opening quote has been consumed. Regular strings end
+// at a line break so an unpaired quote in markup text only hides the rest of
+// its line; verbatim strings end at a quote that is not doubled.
+static void skip_string_body(TSLexer *lexer, bool verbatim) {
+    while (!lexer->eof(lexer)) {
+        int32_t c = lexer->lookahead;
+        if (!verbatim && (c == '\n' || c == '\r')) {
+            return;
+        }
+        razor_advance(lexer);
+        if (c == '"') {
+            if (!verbatim || lexer->lookahead != '"') {
+                return;
+            }
+            razor_advance(lexer);
+        } else if (c == '\\' && !verbatim && !lexer->eof(lexer)) {
+            razor_advance(lexer);
+        }
+    }
+}
+
+// Consume a string after its opening quote, telling "" and """raw""" apart
+static void skip_string(TSLexer *lexer, bool verbatim) {
+    razor_advance(lexer);
+    if (verbatim || lexer->lookahead != '"') {
+        skip_string_body(lexer, verbatim);
+        return;
+    }
+    razor_advance(lexer);
+    if (lexer->lookahead != '"') {
+        return;  // Empty string
+    }
+    unsigned quotes = 2;
+    while (lexer->lookahead == '"') {
+        razor_advance(lexer);
+        quotes++;
+    }
+    skip_raw_string_body(lexer, quotes);
+}
+
+// Consume one unit of C#: a string, character literal or comment in full, or
+// else a single character. Brackets inside the skipped literals are not seen
+// by the caller.
+static void skip_csharp_unit(TSLexer *lexer) {
+    switch (lexer->lookahead) {
+        case '"':
+            skip_string(lexer, false);
+            return;
+
+        case '\'':
+            // Apostrophes in markup text are common, so rather than looking
+            // for a closing quote take one character and the quote after it
+            // if there is one. An escape sequence ('\n', '\x41', '\u0041')
+            // runs to the closing quote on its line.
+            razor_advance(lexer);
+            if (lexer->lookahead == '\\') {
+                razor_advance(lexer);
+                if (!lexer->eof(lexer) && lexer->lookahead != '\n') {
+                    razor_advance(lexer);
+                }
+                while (!lexer->eof(lexer) && lexer->lookahead != '\'' && lexer->lookahead != '\n' &&
+                       lexer->lookahead != '\r') {
+                    razor_advance(lexer);
+                }
+            } else if (!lexer->eof(lexer) && lexer->lookahead != '\n') {
+                razor_advance(lexer);
+            }
+            if (lexer->lookahead == '\'') {
+                razor_advance(lexer);
+            }
+            return;
+
+        case '$':
+            razor_advance(lexer);
+            while (lexer->lookahead == '$') {
+                razor_advance(lexer);
+            }
+            if (lexer->lookahead == '@') {
+                razor_advance(lexer);
+                if (lexer->lookahead == '"') {
+                    skip_string(lexer, true);
+                }
+            } else if (lexer->lookahead == '"') {
+                skip_string(lexer, false);
+            }
+            return;
+
+        case '@':
+            razor_advance(lexer);
+            if (lexer->lookahead == '"') {
+                skip_string(lexer, true);
+            } else if (lexer->lookahead == '$') {
+                razor_advance(lexer);
+                if (lexer->lookahead == '"') {
+                    skip_string(lexer, true);
+                }
+            } else if (lexer->lookahead == '*') {
+                // Razor comment
+                razor_advance(lexer);
+                int32_t previous = 0;
+                while (!lexer->eof(lexer) && !(previous == '*' && lexer->lookahead == '@')) {
+                    previous = lexer->lookahead;
+                    razor_advance(lexer);
+                }
+                if (!lexer->eof(lexer)) {
+                    razor_advance(lexer);
+                }
+            }
+            return;
+
+        case '/':
+            razor_advance(lexer);
+            if (lexer->lookahead == '/') {
+                while (!lexer->eof(lexer) && lexer->lookahead != '\n' && lexer->lookahead != '\r') {
+                    razor_advance(lexer);
+                }
+            } else if (lexer->lookahead == '*') {
+                razor_advance(lexer);
+                int32_t previous = 0;
+                while (!lexer->eof(lexer) && !(previous == '*' && lexer->lookahead == '/')) {
+                    previous = lexer->lookahead;
+                    razor_advance(lexer);
+                }
+                if (!lexer->eof(lexer)) {
+                    razor_advance(lexer);
+                }
+            }
+            return;
+
+        default:
+            razor_advance(lexer);
+            return;
+    }
+}
+
+// Consume C# up to (not including) an unmatched `close`, marking the end after
+// the last character that is not whitespace. Returns false at EOF or if there
+// was nothing but whitespace.
+static bool scan_region(TSLexer *lexer, int32_t open, int32_t close) {
+    razor_skip_space(lexer);
+
+    bool has_content = false;
+    unsigned depth = 0;
+    while (!lexer->eof(lexer)) {
+        int32_t c = lexer->lookahead;
+        if (c == close) {
+            if (depth == 0) {
+                return has_content;
+            }
+            depth--;
+        } else if (c == open) {
+            depth++;
+        }
+        if (razor_is_space(c)) {
+            razor_advance(lexer);
+            continue;
+        }
+        skip_csharp_unit(lexer);
+        lexer->mark_end(lexer);
+        has_content = true;
+    }
+    return false;
+}
+
+// Consume a bracketed group starting at `open`, through its matching `close`
+static bool skip_group(TSLexer *lexer, int32_t open, int32_t close) {
+    razor_advance(lexer);
+    unsigned depth = 0;
+    while (!lexer->eof(lexer)) {
+        int32_t c = lexer->lookahead;
+        if (c == close) {
+            razor_advance(lexer);
+            if (depth == 0) {
+                return true;
+            }
+            depth--;
+        } else {
+            if (c == open) {
+                depth++;
+            }
+            skip_csharp_unit(lexer);
+        }
+    }
+    return false;
+}
+
+// Consume a statement header such as `(var item in Items)` or `if (x)` and the
+// '{' that opens its block. A '<' or ';' outside parentheses means there is no
+// block.
+static bool skip_header(TSLexer *lexer) {
+    unsigned depth = 0;
+    while (!lexer->eof(lexer)) {
+        int32_t c = lexer->lookahead;
+        if (c == '{' && depth == 0) {
+            razor_advance(lexer);
+            lexer->mark_end(lexer);
+            return true;
+        }
+        if (depth == 0 && (c == '<' || c == ';')) {
+            return false;
+        }
+        if (c == '(') {
+            depth++;
+        } else if (c == ')' && depth > 0) {
+            depth--;
+        }
+        skip_csharp_unit(lexer);
+    }
+    return false;
+}
+
+typedef enum {
+    BLOCK_FAILED,
+    BLOCK_CLOSED,
+    BLOCK_AT_MARKUP,
+} BlockResult;
+
+// Consume C# in a block with `*depth` braces open, through the brace that
+// closes it, marking the end after the last character that is not
+// whitespace. If `can_split`, stop in front of a tag or an HTML comment that
+// starts a C# statement, which is where Razor goes back to markup.
+static BlockResult skip_block(TSLexer *lexer, unsigned *depth, bool can_split) {
+    // The last character of C#, to tell where a statement starts. A block
+    // and the C# after markup start with one.
+    int32_t last = '{';
+    while (!lexer->eof(lexer)) {
+        int32_t c = lexer->lookahead;
+        if (razor_is_space(c)) {
+            razor_advance(lexer);
+            continue;
+        }
+        if (c == '<' && (last == '{' || last == '}' || last == ';' || last == ':')) {
+            razor_advance(lexer);
+            int32_t next = lexer->lookahead;
+            bool markup = (next >= 'a' && next <= 'z') || (next >= 'A' && next <= 'Z') || next == '/' || next == '!';
+            if (markup && can_split && *depth <= STATEMENT_MAX_DEPTH) {
+                return BLOCK_AT_MARKUP;
+            }
+            lexer->mark_end(lexer);
+            last = c;
+            continue;
+        }
+        if (c == '{') {
+            (*depth)++;
+        } else if (c == '}' && --*depth == 0) {
+            razor_advance(lexer);
+            lexer->mark_end(lexer);
+            return BLOCK_CLOSED;
+        }
+        skip_csharp_unit(lexer);
+        lexer->mark_end(lexer);
+        // Comments do not end a statement, and neither starts with anything
+        // else
+        if (c != '/' && c != '@') {
+            last = c;
+        }
+    }
+    return BLOCK_FAILED;
+}
+
+static StatementKind statement_kind(const char *keyword) {
+    if (strcmp(keyword, "if") == 0) {
+        return STATEMENT_IF;
+    }
+    if (strcmp(keyword, "try") == 0) {
+        return STATEMENT_TRY;
+    }
+    if (strcmp(keyword, "do") == 0) {
+        return STATEMENT_DO;
+    }
+    return STATEMENT_OTHER;
+}
+
+// Clause keywords that continue a statement of the given kind
+static bool continues_statement(StatementKind kind, const char *keyword) {
+    if (strcmp(keyword, "else") == 0) {
+        return kind == STATEMENT_IF;
+    }
+    if (strcmp(keyword, "catch") == 0 || strcmp(keyword, "finally") == 0) {
+        return kind == STATEMENT_TRY;
+    }
+    return false;
+}
+
+// Scan the C# of a statement with `*depth` braces open in it, 0 before the
+// header of its first block, through any else, catch and finally clauses. A
+// clause keyword that does not follow is left for the text after the
+// statement. Stops at markup as skip_block does, leaving `*depth` for the
+// segment after it.
+static BlockResult scan_statement(TSLexer *lexer, StatementKind kind, unsigned *depth, bool can_split) {
+    for (;;) {
+        if (*depth == 0) {
+            if (!skip_header(lexer)) {
+                return BLOCK_FAILED;
+            }
+            *depth = 1;
+        }
+        BlockResult result = skip_block(lexer, depth, can_split);
+        if (result != BLOCK_CLOSED) {
+            return result;
+        }
+
+        if (kind == STATEMENT_DO) {
+            // do { } while (condition);
+            while (razor_is_space(lexer->lookahead)) {
+                razor_advance(lexer);
+            }
+            char next[8];
+            read_identifier(lexer, next, sizeof(next));
+            if (strcmp(next, "while") != 0) {
+                return BLOCK_FAILED;
+            }
+            while (!lexer->eof(lexer) && lexer->lookahead != ';') {
+                if (lexer->lookahead == '(') {
+                    if (!skip_group(lexer, '(', ')')) {
+                        return BLOCK_FAILED;
+                    }
+                } else {
+                    skip_csharp_unit(lexer);
+                }
+            }
+            if (lexer->eof(lexer)) {
+                return BLOCK_FAILED;
+            }
+            razor_advance(lexer);
+            lexer->mark_end(lexer);
+            return BLOCK_CLOSED;
+        }
+
+        while (razor_is_space(lexer->lookahead)) {
+            razor_advance(lexer);
+        }
+        char next[16];
+        read_identifier(lexer, next, sizeof(next));
+        if (!continues_statement(kind, next)) {
+            return BLOCK_CLOSED;
+        }
+    }
+}
+
+// Scan a statement from its keyword. A statement that stops at markup is
+// pushed for the segment after it.
+static bool scan_statement_head(SplitScanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
+    char keyword[16];
+    read_identifier(lexer, keyword, sizeof(keyword));
+    StatementKind kind = statement_kind(keyword);
+    unsigned depth = 0;
+
+    bool can_split = valid_symbols[CSHARP_STATEMENT_HEAD] && scanner->statement_count < STATEMENT_STACK_CAPACITY;
+    switch (scan_statement(lexer, kind, &depth, can_split)) {
+        case BLOCK_CLOSED:
+            lexer->result_symbol = CSHARP_STATEMENT;
+            return valid_symbols[CSHARP_STATEMENT];
+        case BLOCK_AT_MARKUP:
+            scanner->statements[scanner->statement_count++] = (uint8_t)(kind << STATEMENT_KIND_SHIFT | depth);
+            lexer->result_symbol = CSHARP_STATEMENT_HEAD;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Scan the C# after markup in the innermost statement stopped at it
+static bool scan_statement_continuation(SplitScanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
+    uint8_t *statement = &scanner->statements[scanner->statement_count - 1];
+    StatementKind kind = (StatementKind)(*statement >> STATEMENT_KIND_SHIFT);
+    unsigned depth = *statement & STATEMENT_MAX_DEPTH;
+
+    switch (scan_statement(lexer, kind, &depth, true)) {
+        case BLOCK_CLOSED:
+            scanner->statement_count--;
+            lexer->result_symbol = CSHARP_STATEMENT_TAIL;
+            return valid_symbols[CSHARP_STATEMENT_TAIL];
+        case BLOCK_AT_MARKUP:
+            *statement = (uint8_t)(kind << STATEMENT_KIND_SHIFT | depth);
+            lexer->result_symbol = CSHARP_STATEMENT_BODY;
+            return valid_symbols[CSHARP_STATEMENT_BODY];
+        default:
+            return false;
+    }
+}
+
+// identifier, then any run of .member, ?.member, (arguments) and [index].
+// A '.' that is not followed by a member ends the expression before it, so
+// the full stop in "Hello @Model.Name." stays text.
+static bool scan_implicit_expression(TSLexer *lexer) {
+    if (!is_identifier_start(lexer->lookahead)) {
+        return false;
+    }
+
+    char word[8];
+    read_identifier(lexer, word, sizeof(word));
+    if (strcmp(word, "await") == 0 && is_inline_space(lexer->lookahead)) {
+        while (is_inline_space(lexer->lookahead)) {
+            razor_advance(lexer);
+        }
+        if (!is_identifier_start(lexer->lookahead)) {
+            return false;
+        }
+        read_identifier(lexer, word, sizeof(word));
+    }
+    lexer->mark_end(lexer);
+
+    for (;;) {
+        switch (lexer->lookahead) {
+            case '?':
+                razor_advance(lexer);
+                if (lexer->lookahead != '.') {
+                    return true;
+                }
+                // fallthrough
+            case '.':
+                razor_advance(lexer);
+                if (!is_identifier_start(lexer->lookahead)) {
+                    return true;
+                }
+                read_identifier(lexer, word, sizeof(word));
+                break;
+            case '(':
+                if (!skip_group(lexer, '(', ')')) {
+                    return true;
+                }
+                break;
+            case '[':
+                if (!skip_group(lexer, '[', ']')) {
+                    return true;
+                }
+                break;
+            default:
+                return true;
+        }
+        lexer->mark_end(lexer);
+    }
+}
+
+// The rest of the line, without surrounding whitespace
+static bool scan_directive_argument(TSLexer *lexer) {
+    while (is_inline_space(lexer->lookahead)) {
+        razor_skip(lexer);
+    }
+
+    bool has_content = false;
+    while (!lexer->eof(lexer) && lexer->lookahead != '\n' && lexer->lookahead != '\r') {
+        bool space = is_inline_space(lexer->lookahead);
+        razor_advance(lexer);
+        if (!space) {
+            lexer->mark_end(lexer);
+            has_content = true;
+        }
+    }
+    return has_content;
+}
+
+// =============================================================================
+// Scanner lifecycle functions
+// =============================================================================
+
+void *tree_sitter_razor_split_external_scanner_create() {
+    SplitScanner *scanner = ts_malloc(sizeof(SplitScanner));
+    scanner->statement_count = 0;
+    return scanner;
+}
+
+void tree_sitter_razor_split_external_scanner_destroy(void *payload) { ts_free(payload); }
+
+// Serialized layout: the statements, innermost last
+unsigned tree_sitter_razor_split_external_scanner_serialize(void *payload, char *buffer) {
+    SplitScanner *scanner = (SplitScanner *)payload;
+    memcpy(buffer, scanner->statements, scanner->statement_count);
+    return scanner->statement_count;
+}
+
+void tree_sitter_razor_split_external_scanner_deserialize(void *payload, const char *buffer, unsigned length) {
+    SplitScanner *scanner = (SplitScanner *)payload;
+    if (length > STATEMENT_STACK_CAPACITY) {
+        length = 0;
+    }
+    memcpy(scanner->statements, buffer, length);
+    scanner->statement_count = (uint8_t)length;
+}
+
+// =============================================================================
+// Main scan function
+// =============================================================================
+
+bool tree_sitter_razor_split_external_scanner_scan(void *payload, TSLexer *lexer, const bool *valid_symbols) {
+    SplitScanner *scanner = (SplitScanner *)payload;
+
+    // During error recovery every token is valid; the C# regions are only
+    // meaningful right after their opening delimiters, so leave recovery to
+    // the text tokens. The statements stopped at markup are those the error
+    // cut short, so they are dropped with whatever token is next.
+    bool error_recovery = valid_symbols[CSHARP_BRACED_CONTENT] && valid_symbols[RAZOR_STATEMENT_START];
+    if (error_recovery) {
+        scanner->statement_count = 0;
+    }
+
+    if (!error_recovery) {
+        if (valid_symbols[CSHARP_BRACED_CONTENT]) {
+            lexer->result_symbol = CSHARP_BRACED_CONTENT;
+            return scan_region(lexer, '{', '}');
+        }
+        if (valid_symbols[CSHARP_PARENTHESIZED_CONTENT]) {
+            lexer->result_symbol = CSHARP_PARENTHESIZED_CONTENT;
+            return scan_region(lexer, '(', ')');
+        }
+        if (valid_symbols[CSHARP_STATEMENT] || valid_symbols[CSHARP_STATEMENT_HEAD]) {
+            return scan_statement_head(scanner, lexer, valid_symbols);
+        }
+        // After markup in a statement, either more markup, which the grammar
+        // scans, or its next C# segment
+        if ((valid_symbols[CSHARP_STATEMENT_BODY] || valid_symbols[CSHARP_STATEMENT_TAIL]) &&
+            scanner->statement_count > 0) {
+            razor_skip_space(lexer);
+            if (lexer->lookahead != '<') {
+                return scan_statement_continuation(scanner, lexer, valid_symbols);
+            }
+        }
+        if (valid_symbols[CSHARP_DIRECTIVE_ARGUMENT] && scan_directive_argument(lexer)) {
+            lexer->result_symbol = CSHARP_DIRECTIVE_ARGUMENT;
+            return true;
+        }
+        if (valid_symbols[CSHARP_IMPLICIT_EXPRESSION]) {
+            lexer->result_symbol = CSHARP_IMPLICIT_EXPRESSION;
+            return scan_implicit_expression(lexer);
+        }
+
+        // '@' followed by a statement keyword, or a comment. Only the '@' is
+        // the statement token; the keyword is looked at without being
+        // consumed. The scanner runs before extras are skipped, so skip the
+        // whitespace in front here.
+        bool at_valid = valid_symbols[RAZOR_STATEMENT_START] || valid_symbols[RAZOR_COMMENT];
+        if (at_valid || valid_symbols[HTML_COMMENT]) {
+            razor_skip_space(lexer);
+        }
+        if (at_valid && lexer->lookahead == '@') {
+            razor_advance(lexer);
+            if (valid_symbols[RAZOR_COMMENT] && scan_razor_comment(lexer)) {
+                lexer->result_symbol = RAZOR_COMMENT;
+                return true;
+            }
+            lexer->mark_end(lexer);
+            if (valid_symbols[RAZOR_STATEMENT_START] &&
+                razor_keyword_starts_statement(lexer, scan_razor_keyword(lexer))) {
+                lexer->result_symbol = RAZOR_STATEMENT_START;
+                return true;
+            }
+            return false;
+        }
+        if (valid_symbols[HTML_COMMENT] && lexer->lookahead == '<') {
+            razor_advance(lexer);
+            lexer->result_symbol = HTML_COMMENT;
+            return scan_html_comment(lexer);
+        }
+    }
+
+    // Text containing literal @, e.g. email addresses (see the full scanner)
+    bool text_resumable = true;
+    if (valid_symbols[TEXT_WITH_LITERAL_AT]) {
+        if (scan_literal_at(lexer, &text_resumable)) {
+            lexer->result_symbol = TEXT_WITH_LITERAL_AT;
+            return true;
+        }
+    }
+
+    // Statements are single tokens here, else/catch/finally included, so
+    // text has no keywords to stop in front of
+    if (valid_symbols[HTML_TEXT_CONTENT] && text_resumable) {
+        bool stopped_at_keyword;
+        if (scan_html_text(lexer, false, &stopped_at_keyword)) {
+            lexer->result_symbol = HTML_TEXT_CONTENT;
+            return true;
+        }
+    }
+
+    for (unsigned i = 0; i < RAW_TEXT_TAG_COUNT; i++) {
+        if (valid_symbols[SCRIPT_CONTENT + i]) {
+            if (scan_raw_text(lexer, &RAW_TEXT_TAGS[i])) {
+                lexer->result_symbol = SCRIPT_CONTENT + i;
+                return true;
+            }
+            return false;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,582 @@
+/**
+ * HTML text, raw text and comment scanning shared by the Razor scanners
+ *
+ * Used by src/scanner.c and by the split grammar's scanner
+ * (split/src/scanner.c), which leaves C# to an injected parser and so has no
+ * C# scanner of its own. Include it after tree_sitter/parser.h.
+ */
+
+#ifndef TREE_SITTER_RAZOR_TEXT_H_
+#define TREE_SITTER_RAZOR_TEXT_H_
+
+#include "unicode.h"
+
+#include <string.h>
+#include <wctype.h>
+
+static inline void razor_advance(TSLexer *lexer) { lexer->advance(lexer, false); }
+
+static inline void razor_skip(TSLexer *lexer) { lexer->advance(lexer, true); }
+
+// Same answers as iswspace, but ASCII (nearly all of the whitespace in real
+// markup) is classified inline instead of through the locale tables
+static inline bool razor_is_space(int32_t c) {
+    if (c < 0x80) {
+        return c == ' ' || (uint32_t)(c - '\t') <= '\r' - '\t';
+    }
+    return iswspace((wint_t)c);
+}
+
+static inline void razor_skip_space(TSLexer *lexer) {
+    while (razor_is_space(lexer->lookahead)) {
+        razor_skip(lexer);
+    }
+}
+
+// =============================================================================
+// Text content
+// =============================================================================
+
+// How far the literal @ search and raw text read on their own account.
+// Past this many characters the search gives up at the next line break and
+// raw text ends at the next chunk boundary, so the range an edit
+// invalidates follows the edit rather than the length of the text run, or
+// of the file when an end tag is missing. Builds can set their own.
+#ifndef RAZOR_LOOKAHEAD_LIMIT
+#define RAZOR_LOOKAHEAD_LIMIT 1024
+#endif
+
+// Character classes for the text scanners. HTML_TEXT_CONTENT ends at a
+// TEXT_DELIMITER and re-runs its line-start keyword check after a
+// TEXT_NEWLINE. The TEXT_WITH_LITERAL_AT search only stops at a
+// TEXT_LITERAL_AT_STOP, where it also checks the lookahead limit on a line
+// break. Everything else, including all non-ASCII characters, is plain text.
+enum {
+    TEXT_DELIMITER = 1,
+    TEXT_NEWLINE = 2,
+    TEXT_LITERAL_AT_STOP = 4,
+};
+
+static const uint8_t TEXT_CLASS[128] = {
+    ['\n'] = TEXT_NEWLINE | TEXT_LITERAL_AT_STOP, ['\r'] = TEXT_NEWLINE,
+    ['<'] = TEXT_DELIMITER | TEXT_LITERAL_AT_STOP, ['@'] = TEXT_DELIMITER | TEXT_LITERAL_AT_STOP,
+    ['"'] = TEXT_DELIMITER | TEXT_LITERAL_AT_STOP, ['\''] = TEXT_DELIMITER | TEXT_LITERAL_AT_STOP,
+    ['.'] = TEXT_DELIMITER, ['['] = TEXT_DELIMITER, ['('] = TEXT_DELIMITER,
+};
+
+static inline bool is_html_text_special(int32_t c) {
+    return c >= 0 && c < 128 && (TEXT_CLASS[c] & (TEXT_DELIMITER | TEXT_NEWLINE)) != 0;
+}
+
+static inline bool is_html_text_delimiter(int32_t c) {
+    return c >= 0 && c < 128 && (TEXT_CLASS[c] & TEXT_DELIMITER) != 0;
+}
+
+static inline bool is_literal_at_stop(int32_t c) {
+    return c >= 0 && c < 128 && (TEXT_CLASS[c] & TEXT_LITERAL_AT_STOP) != 0;
+}
+
+// Check if character is a "word" character for email address detection.
+// Per Razor lexer: char.IsLetter(c) || char.IsDigit(c)
+// - IsLetter: UppercaseLetter, LowercaseLetter, TitlecaseLetter, ModifierLetter, OtherLetter
+// - IsDigit: DecimalDigitNumber
+// Non-ASCII characters are looked up in the generated tables in unicode.h.
+static inline bool is_email_char(int32_t c) {
+    if (c < 0x80) {
+        return (uint32_t)((c | 0x20) - 'a') < 26 || (uint32_t)(c - '0') < 10;
+    }
+    return unicode_is_word_char(c);
+}
+
+// Check if character can be part of a C# identifier (for keyword boundary detection)
+static inline bool is_identifier_char(int32_t c) {
+    return is_email_char(c) || c == '_';
+}
+
+static inline bool is_identifier_start(int32_t c) {
+    return c == '_' || (is_email_char(c) && (uint32_t)(c - '0') >= 10);
+}
+
+// Scan text for a word@word pattern such as an email address. Returns true
+// with the token end marked if one was found. Otherwise the lexer is left
+// where the search stopped and *consumed_at reports whether that is just past
+// an '@' (one preceded by a word character but not followed by one).
+//
+// The search ends at the first line break past RAZOR_LOOKAHEAD_LIMIT
+// characters, after it, so that whatever token comes next starts a line, as
+// it would after any other text. A literal @ found by then ends the token
+// there; one further on is found by the search from the next token.
+static bool scan_literal_at(TSLexer *lexer, bool *consumed_at) {
+    bool found_literal_at = false;
+    int32_t previous = 0;  // Last character consumed, 0 if it cannot precede a literal @
+    uint32_t length = 0;
+    *consumed_at = false;
+
+    for (;;) {
+        // Plain text only matters through the character in front of an '@'
+        while (!lexer->eof(lexer) && !is_literal_at_stop(lexer->lookahead)) {
+            previous = lexer->lookahead;
+            razor_advance(lexer);
+            length++;
+        }
+
+        if (lexer->lookahead == '\n') {
+            razor_advance(lexer);
+            if (++length >= RAZOR_LOOKAHEAD_LIMIT) {
+                break;
+            }
+            previous = 0;
+            continue;
+        }
+
+        // @ not preceded by word - stop here, this @ might be a Razor construct
+        if (lexer->eof(lexer) || lexer->lookahead != '@' || !is_email_char(previous)) {
+            break;
+        }
+
+        // Found word char followed by @. Mark before it in case it turns out
+        // not to be followed by a domain part.
+        if (found_literal_at) {
+            lexer->mark_end(lexer);
+        }
+        razor_advance(lexer);  // consume @
+        length++;
+        if (!is_email_char(lexer->lookahead)) {
+            *consumed_at = true;
+            return found_literal_at;
+        }
+
+        // Consume the domain part, then continue scanning in case there are
+        // more @ signs
+        found_literal_at = true;
+        while (is_email_char(lexer->lookahead) || lexer->lookahead == '.' || lexer->lookahead == '-') {
+            razor_advance(lexer);
+            length++;
+        }
+        previous = 0;
+    }
+
+    if (found_literal_at) {
+        lexer->mark_end(lexer);
+    }
+    return found_literal_at;
+}
+
+// Scan HTML text up to the next HTML/Razor marker. With stop_at_keywords,
+// text also ends in front of an else/catch/finally at the start of a line so
+// the grammar can attach it to the preceding @if/@try. Returns true with the
+// token end marked if any text was consumed; otherwise *stopped_at_keyword
+// reports whether that was because a keyword came first.
+static bool scan_html_text(TSLexer *lexer, bool stop_at_keywords, bool *stopped_at_keyword) {
+    bool has_content = false;
+    bool found_keyword = false;
+    bool at_line_start = true;  // Track if we're at the logical start of a line
+
+    while (!lexer->eof(lexer)) {
+        int32_t c = lexer->lookahead;
+
+        // Fast path: in the middle of a line only a delimiter or a line
+        // break matters, so take the whole run of plain text at once.
+        // The token end is marked once on the way out.
+        if (!at_line_start && !is_html_text_special(c)) {
+            do {
+                razor_advance(lexer);
+            } while (!lexer->eof(lexer) && !is_html_text_special(lexer->lookahead));
+            has_content = true;
+            continue;
+        }
+
+        // Stop at HTML/Razor markers, expression continuations and string
+        // delimiters (for directive arguments like @page "/route")
+        if (is_html_text_delimiter(c)) {
+            break;
+        }
+
+        // Track newlines to know when we're at line start
+        if (c == '\n' || c == '\r') {
+            razor_advance(lexer);
+            has_content = true;
+            at_line_start = true;
+            continue;
+        }
+
+        // Whitespace at line start doesn't change at_line_start
+        if (at_line_start && (c == ' ' || c == '\t')) {
+            razor_advance(lexer);
+            has_content = true;
+            continue;
+        }
+
+        // Check for keywords only at line start
+        // If we see 'e', 'c', or 'f' at line start, check for else/catch/finally
+        if (stop_at_keywords && at_line_start && (c == 'e' || c == 'c' || c == 'f')) {
+            lexer->mark_end(lexer);
+
+            // Peek ahead to check for keywords
+            char keyword_buf[8] = {0};
+            int keyword_len = 0;
+            int32_t start_char = c;
+
+            while (keyword_len < 7 && is_identifier_char(lexer->lookahead)) {
+                // Non-ASCII letters never spell a keyword; keep them from
+                // truncating to one that does
+                keyword_buf[keyword_len++] = lexer->lookahead < 0x80 ? (char)lexer->lookahead : '\x7F';
+                razor_advance(lexer);
+            }
+            keyword_buf[keyword_len] = '\0';
+
+            // Check if we found a keyword followed by whitespace, brace, or paren
+            bool is_keyword = false;
+            if (!is_identifier_char(lexer->lookahead)) {
+                if (start_char == 'e' && strcmp(keyword_buf, "else") == 0) {
+                    is_keyword = true;
+                } else if (start_char == 'c' && strcmp(keyword_buf, "catch") == 0) {
+                    is_keyword = true;
+                } else if (start_char == 'f' && strcmp(keyword_buf, "finally") == 0) {
+                    is_keyword = true;
+                }
+            }
+
+            if (is_keyword) {
+                // Stop here - don't consume the keyword
+                found_keyword = true;
+                break;
+            }
+
+            // Not a keyword, the characters we advanced over are content
+            has_content = true;
+            at_line_start = false;
+            continue;
+        }
+
+        // Any other character - no longer at line start
+        razor_advance(lexer);
+        has_content = true;
+        at_line_start = false;
+    }
+
+    // A keyword stop has already marked the end in front of the keyword
+    if (has_content && !found_keyword) {
+        lexer->mark_end(lexer);
+    }
+
+    *stopped_at_keyword = found_keyword && !has_content;
+    return has_content;
+}
+
+// =============================================================================
+// Raw text elements (script, style, title, textarea)
+// =============================================================================
+
+// End tag for each raw text element. Names are lowercase; matching folds case.
+// Scanners declare the content tokens in this order, so entry i goes with
+// the first raw text token + i.
+typedef struct {
+    const char *name;
+    uint8_t length;
+} RawTextTag;
+
+static const RawTextTag RAW_TEXT_TAGS[] = {
+    {"script", 6},
+    {"style", 5},
+    {"title", 5},
+    {"textarea", 8},
+};
+
+#define RAW_TEXT_TAG_COUNT (sizeof(RAW_TEXT_TAGS) / sizeof(RAW_TEXT_TAGS[0]))
+
+// Raw text is handed out in chunks, each ending just after the first line
+// break, ';' or '}' past RAZOR_LOOKAHEAD_LIMIT characters. An edit then
+// re-lexes the chunk it falls in, and the boundaries after it fall where
+// they did before as soon as one of them is past the edit. Text with none
+// of those characters is cut at RAW_TEXT_CHUNK_MAX_LENGTH.
+#define RAW_TEXT_CHUNK_MAX_LENGTH (4 * RAZOR_LOOKAHEAD_LIMIT)
+
+static inline bool is_raw_text_chunk_end(int32_t c) { return c == '\n' || c == ';' || c == '}'; }
+
+// Scan one chunk of raw text, up to (not including) the closing tag, e.g.
+// </script, if that comes first.
+//
+// Only '<' can start the end tag, so everything else is consumed without
+// looking at it. mark_end is called once per '<' (and at EOF) rather than once
+// per character; when a candidate turns out not to be the end tag, the
+// characters read while checking it are simply covered by the next mark_end.
+static bool scan_raw_text(TSLexer *lexer, const RawTextTag *tag) {
+    bool has_content = false;
+    uint32_t length = 0;
+
+    for (;;) {
+        while (lexer->lookahead != '<' && !lexer->eof(lexer)) {
+            int32_t c = lexer->lookahead;
+            razor_advance(lexer);
+            has_content = true;
+            if (++length >= RAZOR_LOOKAHEAD_LIMIT &&
+                (is_raw_text_chunk_end(c) || length >= RAW_TEXT_CHUNK_MAX_LENGTH)) {
+                lexer->mark_end(lexer);
+                return true;
+            }
+        }
+
+        // Content ends before this '<' unless it turns out to be ordinary text
+        lexer->mark_end(lexer);
+        if (lexer->eof(lexer)) {
+            break;
+        }
+
+        razor_advance(lexer);
+        if (lexer->lookahead == '/') {
+            razor_advance(lexer);
+            uint8_t i = 0;
+            // ASCII case fold; only letters can match since tag names are letters
+            while (i < tag->length && (lexer->lookahead | 0x20) == tag->name[i]) {
+                razor_advance(lexer);
+                i++;
+            }
+            // The name has to end there, as in </script> or </script >, not
+            // </scripts>
+            int32_t next = lexer->lookahead;
+            if (i == tag->length && (next == '>' || next == '/' || razor_is_space(next) || lexer->eof(lexer))) {
+                // Found the end tag - content stops at the '<' marked above
+                break;
+            }
+        }
+
+        // Not the end tag: the '<' and anything read after it is content
+        has_content = true;
+    }
+
+    return has_content;
+}
+
+// =============================================================================
+// Comments (@* *@ and <!-- -->)
+// =============================================================================
+
+// Both scanners are called with the lexer just past the first character of
+// the opener, so the caller can still fall back to other tokens that start
+// with '@' or '<'. The body search only stops at the first character of the
+// terminator. An unterminated comment runs to the end of the input, like an
+// unterminated C# block comment. Nothing past the terminator is read, so an
+// edit outside a comment never invalidates it.
+
+// Scan a Razor comment: @* ... *@
+static bool scan_razor_comment(TSLexer *lexer) {
+    if (lexer->lookahead != '*') {
+        return false;
+    }
+    razor_advance(lexer);
+
+    while (!lexer->eof(lexer)) {
+        while (lexer->lookahead != '*' && !lexer->eof(lexer)) {
+            razor_advance(lexer);
+        }
+        if (lexer->eof(lexer)) {
+            break;
+        }
+        razor_advance(lexer);  // consume *
+        if (lexer->lookahead == '@') {
+            razor_advance(lexer);
+            break;
+        }
+    }
+
+    lexer->mark_end(lexer);
+    return true;
+}
+
+// Scan an HTML comment: <!-- ... -->
+static bool scan_html_comment(TSLexer *lexer) {
+    for (const char *opener = "!--"; *opener; opener++) {
+        if (lexer->lookahead != *opener) {
+            return false;
+        }
+        razor_advance(lexer);
+    }
+
+    while (!lexer->eof(lexer)) {
+        while (lexer->lookahead != '-' && !lexer->eof(lexer)) {
+            razor_advance(lexer);
+        }
+        if (lexer->eof(lexer)) {
+            break;
+        }
+        razor_advance(lexer);  // consume -
+        if (lexer->lookahead != '-') {
+            continue;
+        }
+        // Any run of two or more dashes can end the comment (--->)
+        while (lexer->lookahead == '-') {
+            razor_advance(lexer);
+        }
+        if (lexer->lookahead == '>') {
+            razor_advance(lexer);
+            break;
+        }
+    }
+
+    lexer->mark_end(lexer);
+    return true;
+}
+
+// =============================================================================
+// Keywords after @ (directives and statements)
+// =============================================================================
+
+// Names that mean something after an '@' in markup. The directives come
+// first, in the order the full scanner declares their keyword tokens, so
+// keyword i goes with the first directive token + i.
+typedef enum {
+    RAZOR_KEYWORD_NONE,
+    RAZOR_KEYWORD_PAGE,
+    RAZOR_KEYWORD_MODEL,
+    RAZOR_KEYWORD_INJECT,
+    RAZOR_KEYWORD_INHERITS,
+    RAZOR_KEYWORD_NAMESPACE,
+    RAZOR_KEYWORD_FUNCTIONS,
+    RAZOR_KEYWORD_CODE,
+    RAZOR_KEYWORD_SECTION,
+    RAZOR_KEYWORD_LAYOUT,
+    RAZOR_KEYWORD_ATTRIBUTE,
+    RAZOR_KEYWORD_IMPLEMENTS,
+    RAZOR_KEYWORD_TYPEPARAM,
+    RAZOR_KEYWORD_PRESERVEWHITESPACE,
+    RAZOR_KEYWORD_RENDERMODE,
+    RAZOR_KEYWORD_ADDTAGHELPER,
+    RAZOR_KEYWORD_REMOVETAGHELPER,
+    RAZOR_KEYWORD_TAGHELPERPREFIX,
+    // Statements (see razor_statement). `using` is also the
+    // @using directive, and `await` only counts in front of `using`.
+    RAZOR_KEYWORD_IF,
+    RAZOR_KEYWORD_FOR,
+    RAZOR_KEYWORD_FOREACH,
+    RAZOR_KEYWORD_WHILE,
+    RAZOR_KEYWORD_DO,
+    RAZOR_KEYWORD_SWITCH,
+    RAZOR_KEYWORD_TRY,
+    RAZOR_KEYWORD_LOCK,
+    RAZOR_KEYWORD_USING,
+    RAZOR_KEYWORD_AWAIT,
+} RazorKeyword;
+
+// Longest keyword, "preservewhitespace"
+#define RAZOR_KEYWORD_MAX_LENGTH 18
+
+static inline bool razor_keyword_is_directive(RazorKeyword keyword) {
+    return keyword >= RAZOR_KEYWORD_PAGE && keyword <= RAZOR_KEYWORD_TAGHELPERPREFIX;
+}
+
+// Look a word up: one switch on its first letter, then a comparison of the
+// rest only against the keywords of the same length
+static RazorKeyword razor_keyword(const char *word, unsigned length) {
+#define RAZOR_KEYWORD_CASE(text, keyword)                                             \
+    if (length == sizeof(text) - 1 && memcmp(word + 1, text + 1, length - 1) == 0) { \
+        return keyword;                                                               \
+    }
+
+    switch (word[0]) {
+        case 'a':
+            RAZOR_KEYWORD_CASE("addTagHelper", RAZOR_KEYWORD_ADDTAGHELPER)
+            RAZOR_KEYWORD_CASE("attribute", RAZOR_KEYWORD_ATTRIBUTE)
+            RAZOR_KEYWORD_CASE("await", RAZOR_KEYWORD_AWAIT)
+            break;
+        case 'c':
+            RAZOR_KEYWORD_CASE("code", RAZOR_KEYWORD_CODE)
+            break;
+        case 'd':
+            RAZOR_KEYWORD_CASE("do", RAZOR_KEYWORD_DO)
+            break;
+        case 'f':
+            RAZOR_KEYWORD_CASE("for", RAZOR_KEYWORD_FOR)
+            RAZOR_KEYWORD_CASE("foreach", RAZOR_KEYWORD_FOREACH)
+            RAZOR_KEYWORD_CASE("functions", RAZOR_KEYWORD_FUNCTIONS)
+            break;
+        case 'i':
+            RAZOR_KEYWORD_CASE("if", RAZOR_KEYWORD_IF)
+            RAZOR_KEYWORD_CASE("inject", RAZOR_KEYWORD_INJECT)
+            RAZOR_KEYWORD_CASE("inherits", RAZOR_KEYWORD_INHERITS)
+            RAZOR_KEYWORD_CASE("implements", RAZOR_KEYWORD_IMPLEMENTS)
+            break;
+        case 'l':
+            RAZOR_KEYWORD_CASE("layout", RAZOR_KEYWORD_LAYOUT)
+            RAZOR_KEYWORD_CASE("lock", RAZOR_KEYWORD_LOCK)
+            break;
+        case 'm':
+            RAZOR_KEYWORD_CASE("model", RAZOR_KEYWORD_MODEL)
+            break;
+        case 'n':
+            RAZOR_KEYWORD_CASE("namespace", RAZOR_KEYWORD_NAMESPACE)
+            break;
+        case 'p':
+            RAZOR_KEYWORD_CASE("page", RAZOR_KEYWORD_PAGE)
+            RAZOR_KEYWORD_CASE("preservewhitespace", RAZOR_KEYWORD_PRESERVEWHITESPACE)
+            break;
+        case 'r':
+            RAZOR_KEYWORD_CASE("rendermode", RAZOR_KEYWORD_RENDERMODE)
+            RAZOR_KEYWORD_CASE("removeTagHelper", RAZOR_KEYWORD_REMOVETAGHELPER)
+            break;
+        case 's':
+            RAZOR_KEYWORD_CASE("section", RAZOR_KEYWORD_SECTION)
+            RAZOR_KEYWORD_CASE("switch", RAZOR_KEYWORD_SWITCH)
+            break;
+        case 't':
+            RAZOR_KEYWORD_CASE("tagHelperPrefix", RAZOR_KEYWORD_TAGHELPERPREFIX)
+            RAZOR_KEYWORD_CASE("try", RAZOR_KEYWORD_TRY)
+            RAZOR_KEYWORD_CASE("typeparam", RAZOR_KEYWORD_TYPEPARAM)
+            break;
+        case 'u':
+            RAZOR_KEYWORD_CASE("using", RAZOR_KEYWORD_USING)
+            break;
+        case 'w':
+            RAZOR_KEYWORD_CASE("while", RAZOR_KEYWORD_WHILE)
+            break;
+        default:
+            break;
+    }
+    return RAZOR_KEYWORD_NONE;
+
+#undef RAZOR_KEYWORD_CASE
+}
+
+// Consume an identifier and look it up. Anything that is not exactly a
+// keyword, such as @pageTitle, is RAZOR_KEYWORD_NONE.
+static RazorKeyword scan_razor_keyword(TSLexer *lexer) {
+    char word[RAZOR_KEYWORD_MAX_LENGTH];
+    unsigned length = 0;
+    while (is_identifier_char(lexer->lookahead)) {
+        if (length < RAZOR_KEYWORD_MAX_LENGTH) {
+            // Non-ASCII letters never spell a keyword, as in scan_html_text
+            word[length] = lexer->lookahead < 0x80 ? (char)lexer->lookahead : '\x7F';
+        }
+        length++;
+        razor_advance(lexer);
+    }
+    if (length == 0 || length > RAZOR_KEYWORD_MAX_LENGTH) {
+        return RAZOR_KEYWORD_NONE;
+    }
+    return razor_keyword(word, length);
+}
+
+// Whether `keyword`, just consumed after an '@', starts one of the statements
+// the grammars support. `using` only does with a parenthesised resource, with
+// or without `await` in front; otherwise it is the @using directive or an
+// awaited expression.
+static bool razor_keyword_starts_statement(TSLexer *lexer, RazorKeyword keyword) {
+    if (keyword == RAZOR_KEYWORD_AWAIT) {
+        while (lexer->lookahead == ' ' || lexer->lookahead == '\t') {
+            razor_advance(lexer);
+        }
+        keyword = scan_razor_keyword(lexer);
+        if (keyword != RAZOR_KEYWORD_USING) {
+            return false;
+        }
+    }
+    if (keyword == RAZOR_KEYWORD_USING) {
+        while (razor_is_space(lexer->lookahead)) {
+            razor_advance(lexer);
+        }
+        return lexer->lookahead == '(';
+    }
+    return keyword >= RAZOR_KEYWORD_IF && keyword < RAZOR_KEYWORD_USING;
+}
+
+#endif // TREE_SITTER_RAZOR_TEXT_H_
@@ -2,14 +2,16 @@
  * Razor external scanner
  *
  * This scanner wraps the C# scanner and adds Razor-specific token handling.
- * The C# scanner is treated as a black box - we include it and delegate to it
- * for C# tokens.
+ * The C# scanner is included as source and delegated to for C# tokens; only
+ * its state struct is used directly, so it can live inside RazorScanner.
  */
 
 #include "tree_sitter/alloc.h"
 #include "tree_sitter/array.h"
 #include "tree_sitter/parser.h"
 
+#include "razor_text.h"
+
 // =============================================================================
 // Include C# scanner
 // =============================================================================
@@ -40,8 +42,36 @@ enum RazorTokenType {
     STYLE_CONTENT,           // Raw content inside <style> tags
     TITLE_CONTENT,           // Raw content inside <title> tags
     TEXTAREA_CONTENT,        // Raw content inside <textarea> tags
+    // Comments in markup
+    RAZOR_COMMENT,           // @* ... *@
+    HTML_COMMENT,            // <!-- ... -->
+    RAZOR_MEMBER_DOT,        // '.' continuing an implicit expression, in front of a member name
+    // Keywords after @ in markup, told apart with one lookup (see razor_keyword)
+    RAZOR_STATEMENT_START,   // '@' in front of a statement keyword
+    PAGE_DIRECTIVE_KEYWORD,  // @page, the first of the directive keywords
+    MODEL_DIRECTIVE_KEYWORD,
+    INJECT_DIRECTIVE_KEYWORD,
+    INHERITS_DIRECTIVE_KEYWORD,
+    NAMESPACE_DIRECTIVE_KEYWORD,
+    FUNCTIONS_DIRECTIVE_KEYWORD,
+    CODE_DIRECTIVE_KEYWORD,
+    SECTION_DIRECTIVE_KEYWORD,
+    LAYOUT_DIRECTIVE_KEYWORD,
+    ATTRIBUTE_DIRECTIVE_KEYWORD,
+    IMPLEMENTS_DIRECTIVE_KEYWORD,
+    TYPEPARAM_DIRECTIVE_KEYWORD,
+    PRESERVEWHITESPACE_DIRECTIVE_KEYWORD,
+    RENDERMODE_DIRECTIVE_KEYWORD,
+    ADDTAGHELPER_DIRECTIVE_KEYWORD,
+    REMOVETAGHELPER_DIRECTIVE_KEYWORD,
+    TAGHELPERPREFIX_DIRECTIVE_KEYWORD,
+    EXTERNAL_TOKEN_COUNT,
 };
 
+// The directive keyword tokens are declared in RazorKeyword order, so
+// keyword RAZOR_KEYWORD_PAGE + i goes with token FIRST_DIRECTIVE_KEYWORD + i
+#define FIRST_DIRECTIVE_KEYWORD PAGE_DIRECTIVE_KEYWORD
+
 // =============================================================================
 // Razor scanner state
 // =============================================================================
@@ -53,683 +83,792 @@ typedef enum {
     CONTEXT_CSHARP_PAREN = 2,   // Inside @( ) expression
 } ContextType;
 
+// The context stack is run-length encoded: each run is a 16-bit value holding
+// a type bit and the number of consecutive entries of that type. Deep nesting
+// of one kind (the common case for Blazor markup) costs a single run, so the
+// whole stack fits in a small fixed array. Runs are stored little-endian, in
+// the byte order of the serialized state, so serializing the stack is one
+// copy whatever it holds.
+//
+// A context that would need a run past CONTEXT_RUN_CAPACITY is refused: the
+// token opening it is not produced (see context_push). Only nesting that
+// switches between braces and parentheses more than that many times can get
+// there, and the contexts already open are kept exactly as they were.
+#define CONTEXT_RUN_CAPACITY 64
+#define CONTEXT_RUN_PAREN 0x8000
+#define CONTEXT_RUN_LENGTH_MASK 0x7FFF
+
 typedef struct {
-    void *csharp_scanner;  // Embedded C# scanner (opaque)
-    Array(uint8_t) context_stack;  // Context tracking for C# vs HTML mode
+    Scanner csharp;  // Embedded C# scanner state (see tree_sitter_razor_external_scanner_create)
+    uint8_t context_runs[2 * CONTEXT_RUN_CAPACITY];  // Context tracking for C# vs HTML mode, innermost last
+    uint8_t context_run_count;
 } RazorScanner;
 
 // =============================================================================
 // Helper functions
 // =============================================================================
 
-static inline void razor_advance(TSLexer *lexer) { lexer->advance(lexer, false); }
-
-static inline void razor_skip(TSLexer *lexer) { lexer->advance(lexer, true); }
-
 // Check if scanner is currently in C# context
 static inline bool in_csharp_context(RazorScanner *scanner) {
-    return scanner->context_stack.size > 0;
+    return scanner->context_run_count > 0;
 }
 
-// Check if character is a Unicode letter.
-// This is a locale-independent check that covers the main Unicode letter categories.
-// Note: This is an approximation - a complete implementation would need full Unicode tables.
-static inline bool is_unicode_letter(int32_t c) {
-    // ASCII letters
-    if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) return true;
-
-    // Latin-1 Supplement letters (U+00C0-U+00FF, excluding some non-letters)
-    if (c >= 0x00C0 && c <= 0x00FF && c != 0x00D7 && c != 0x00F7) return true;
-
-    // Latin Extended-A (U+0100-U+017F)
-    if (c >= 0x0100 && c <= 0x017F) return true;
-
-    // Latin Extended-B (U+0180-U+024F)
-    if (c >= 0x0180 && c <= 0x024F) return true;
-
-    // Greek and Coptic (U+0370-U+03FF)
-    if (c >= 0x0370 && c <= 0x03FF) return true;
-
-    // Cyrillic (U+0400-U+04FF)
-    if (c >= 0x0400 && c <= 0x04FF) return true;
-
-    // Hebrew (U+0590-U+05FF)
-    if (c >= 0x0590 && c <= 0x05FF) return true;
-
-    // Arabic (U+0600-U+06FF)
-    if (c >= 0x0600 && c <= 0x06FF) return true;
-
-    // Devanagari (U+0900-U+097F)
-    if (c >= 0x0900 && c <= 0x097F) return true;
-
-    // Thai (U+0E00-U+0E7F)
-    if (c >= 0x0E00 && c <= 0x0E7F) return true;
-
-    // CJK Unified Ideographs (U+4E00-U+9FFF)
-    if (c >= 0x4E00 && c <= 0x9FFF) return true;
-
-    // Hiragana (U+3040-U+309F)
-    if (c >= 0x3040 && c <= 0x309F) return true;
-
-    // Katakana (U+30A0-U+30FF)
-    if (c >= 0x30A0 && c <= 0x30FF) return true;
+static inline uint16_t context_run(const RazorScanner *scanner, unsigned index) {
+    return (uint16_t)(scanner->context_runs[2 * index] | (scanner->context_runs[2 * index + 1] << 8));
+}
 
-    // Hangul Syllables (U+AC00-U+D7AF)
-    if (c >= 0xAC00 && c <= 0xD7AF) return true;
+static inline void context_set_run(RazorScanner *scanner, unsigned index, uint16_t run) {
+    scanner->context_runs[2 * index] = (uint8_t)(run & 0xFF);
+    scanner->context_runs[2 * index + 1] = (uint8_t)(run >> 8);
+}
 
-    return false;
+static inline ContextType context_top(RazorScanner *scanner) {
+    uint16_t run = context_run(scanner, scanner->context_run_count - 1);
+    return (run & CONTEXT_RUN_PAREN) ? CONTEXT_CSHARP_PAREN : CONTEXT_CSHARP_BRACE;
 }
 
-// Check if character is a Unicode decimal digit (0-9 in various scripts)
-static inline bool is_unicode_digit(int32_t c) {
-    // ASCII digits
-    if (c >= '0' && c <= '9') return true;
+// Open a context of the given type. Returns false, leaving the stack as it
+// was, if that needs a new run and all CONTEXT_RUN_CAPACITY are in use, or a
+// run would pass CONTEXT_RUN_LENGTH_MASK entries; the caller then produces no
+// token.
+static bool context_push(RazorScanner *scanner, ContextType type) {
+    uint16_t kind = type == CONTEXT_CSHARP_PAREN ? CONTEXT_RUN_PAREN : 0;
+
+    if (scanner->context_run_count > 0) {
+        unsigned top = scanner->context_run_count - 1;
+        uint16_t run = context_run(scanner, top);
+        if ((run & CONTEXT_RUN_PAREN) == kind) {
+            if ((run & CONTEXT_RUN_LENGTH_MASK) == CONTEXT_RUN_LENGTH_MASK) {
+                return false;
+            }
+            context_set_run(scanner, top, run + 1);
+            return true;
+        }
+    }
 
-    // Other common digit ranges (Arabic-Indic, Extended Arabic-Indic, Devanagari, etc.)
-    // For simplicity, we mainly care about ASCII digits for email detection
-    return false;
+    if (scanner->context_run_count == CONTEXT_RUN_CAPACITY) {
+        return false;
+    }
+    context_set_run(scanner, scanner->context_run_count++, kind | 1);
+    return true;
 }
 
-// Check if character is a "word" character for email address detection.
-// Per Razor lexer: char.IsLetter(c) || char.IsDigit(c)
-// - IsLetter: UppercaseLetter, LowercaseLetter, TitlecaseLetter, ModifierLetter, OtherLetter
-// - IsDigit: DecimalDigitNumber
-static inline bool is_email_char(int32_t c) {
-    return is_unicode_letter(c) || is_unicode_digit(c);
+static inline void context_pop(RazorScanner *scanner) {
+    unsigned top = scanner->context_run_count - 1;
+    uint16_t run = context_run(scanner, top);
+    if ((run & CONTEXT_RUN_LENGTH_MASK) > 1) {
+        context_set_run(scanner, top, run - 1);
+    } else {
+        scanner->context_run_count--;
+    }
 }
 
-// Check if character can be part of a C# identifier (for keyword boundary detection)
-static inline bool is_identifier_char(int32_t c) {
-    return is_unicode_letter(c) || is_unicode_digit(c) || c == '_';
+// Drop every open context, and the C# scanner's state with them. Error
+// recovery can leave behind contexts whose closers it skipped, and nothing
+// would ever pop them (see razor_scan).
+static void context_reset(RazorScanner *scanner) {
+    scanner->context_run_count = 0;
+    tree_sitter_c_sharp_external_scanner_deserialize(&scanner->csharp, NULL, 0);
 }
 
 // =============================================================================
 // Scanner lifecycle functions
 // =============================================================================
 
+// Both scanners' state lives inside one fixed-size block, so creating a
+// scanner costs this one allocation, and scanning a file only allocates when
+// the C# scanner's interpolation stack grows. Only the run count needs
+// initialising; runs past it are never read.
+//
+// The C# state is set up and torn down here the way
+// tree_sitter_c_sharp_external_scanner_create and _destroy do it (a zeroed
+// Scanner with an empty interpolation stack), which ties this file to that
+// struct's layout: revisit both functions when the submodule is updated.
 void *tree_sitter_razor_external_scanner_create() {
-    RazorScanner *scanner = ts_calloc(1, sizeof(RazorScanner));
-    scanner->csharp_scanner = tree_sitter_c_sharp_external_scanner_create();
-    array_init(&scanner->context_stack);
+    RazorScanner *scanner = ts_malloc(sizeof(RazorScanner));
+    memset(&scanner->csharp, 0, sizeof(scanner->csharp));
+    array_init(&scanner->csharp.interpolation_stack);
+    scanner->context_run_count = 0;
     return scanner;
 }
 
 void tree_sitter_razor_external_scanner_destroy(void *payload) {
     RazorScanner *scanner = (RazorScanner *)payload;
-    tree_sitter_c_sharp_external_scanner_destroy(scanner->csharp_scanner);
-    array_delete(&scanner->context_stack);
+    array_delete(&scanner->csharp.interpolation_stack);
     ts_free(scanner);
 }
 
+// Serialized layout: [run_count:1][runs:2*run_count][csharp_state]
+//
+// The runs come first, so they always fit: all CONTEXT_RUN_CAPACITY of them
+// take 2 * CONTEXT_RUN_CAPACITY + 1 bytes, and the C# state gets the rest of
+// the buffer. Deserialize hands the C# scanner everything after the runs, so
+// it never has to know how that scanner lays out its bytes.
+
 unsigned tree_sitter_razor_external_scanner_serialize(void *payload, char *buffer) {
     RazorScanner *scanner = (RazorScanner *)payload;
 
-    // First, serialize C# scanner state
-    unsigned csharp_size = tree_sitter_c_sharp_external_scanner_serialize(scanner->csharp_scanner, buffer);
-
-    // Check if we have room for Razor state
-    unsigned razor_size = 1 + scanner->context_stack.size;  // 1 byte for count + stack contents
-    if (csharp_size + razor_size > TREE_SITTER_SERIALIZATION_BUFFER_SIZE) {
-        return 0;
+    // The runs are already held in their serialized form, so this is a
+    // single copy, or none at all outside of C# context (most HTML tokens)
+    unsigned run_count = scanner->context_run_count;
+    buffer[0] = (char)run_count;
+    memcpy(&buffer[1], scanner->context_runs, 2 * run_count);
+    unsigned size = 1 + 2 * run_count;
+
+    // The C# state may use the whole buffer, so give it its own and copy it
+    // in behind the runs. If it does not fit, it is left out, as the C#
+    // scanner leaves out a state too large for the buffer on its own; that
+    // takes interpolated strings nested hundreds deep.
+    char csharp_buffer[TREE_SITTER_SERIALIZATION_BUFFER_SIZE];
+    unsigned csharp_size = tree_sitter_c_sharp_external_scanner_serialize(&scanner->csharp, csharp_buffer);
+    if (csharp_size > TREE_SITTER_SERIALIZATION_BUFFER_SIZE - size) {
+        return size;
     }
-
-    // Append Razor state after C# state
-    unsigned size = csharp_size;
-    buffer[size++] = (char)scanner->context_stack.size;
-    for (unsigned i = 0; i < scanner->context_stack.size; i++) {
-        buffer[size++] = (char)scanner->context_stack.contents[i];
-    }
-
-    return size;
+    memcpy(&buffer[size], csharp_buffer, csharp_size);
+    return size + csharp_size;
 }
 
 void tree_sitter_razor_external_scanner_deserialize(void *payload, const char *buffer, unsigned length) {
     RazorScanner *scanner = (RazorScanner *)payload;
 
-    array_clear(&scanner->context_stack);
+    scanner->context_run_count = 0;
 
-    if (length == 0) {
-        tree_sitter_c_sharp_external_scanner_deserialize(scanner->csharp_scanner, buffer, 0);
+    unsigned run_count = length > 0 ? (unsigned char)buffer[0] : 0;
+    if (length == 0 || run_count > CONTEXT_RUN_CAPACITY || 1 + 2 * run_count > length) {
+        // Empty or malformed state: start both scanners from scratch
+        tree_sitter_c_sharp_external_scanner_deserialize(&scanner->csharp, buffer, 0);
         return;
     }
 
-    // The C# scanner serializes: 1 byte quote_count + 1 byte interpolation_count + 4 bytes per interpolation
-    // We need to figure out how much of the buffer belongs to C#
-    // Format: [quote_count:1][interp_count:1][interp_data:4*count][razor_context_count:1][context_data:count]
-
-    unsigned char quote_count = (unsigned char)buffer[0];
-    (void)quote_count;  // Not used directly, just for calculating size
-    unsigned char interp_count = (unsigned char)buffer[1];
-    unsigned csharp_size = 2 + interp_count * 4;
-
-    // Deserialize C# state
-    tree_sitter_c_sharp_external_scanner_deserialize(scanner->csharp_scanner, buffer, csharp_size);
-
     // Deserialize Razor state
-    if (length > csharp_size) {
-        unsigned context_count = (unsigned char)buffer[csharp_size++];
-        array_extend(&scanner->context_stack, context_count, &buffer[csharp_size]);
+    memcpy(scanner->context_runs, &buffer[1], 2 * run_count);
+    // Keep the runs up to the first empty one, which a valid state never has
+    while (scanner->context_run_count < run_count &&
+           (context_run(scanner, scanner->context_run_count) & CONTEXT_RUN_LENGTH_MASK) != 0) {
+        scanner->context_run_count++;
     }
+
+    // Deserialize C# state
+    unsigned offset = 1 + 2 * run_count;
+    tree_sitter_c_sharp_external_scanner_deserialize(&scanner->csharp, &buffer[offset], length - offset);
 }
 
 // =============================================================================
 // Main scan function
 // =============================================================================
 
-bool tree_sitter_razor_external_scanner_scan(void *payload, TSLexer *lexer, const bool *valid_symbols) {
-    RazorScanner *scanner = (RazorScanner *)payload;
-
-    // -------------------------------------------------------------------------
-    // Razor-specific tokens (HTML context only)
-    // -------------------------------------------------------------------------
+// Record which token the scanner is trying, so that a rejected scan can be
+// charged to it (see Statistics below). Compiles to nothing by default.
+#ifdef TREE_SITTER_RAZOR_STATS
+#define RAZOR_STATS_TRY(lexer, token) (((RazorStatsLexer *)(lexer))->attempt = (token))
+#else
+#define RAZOR_STATS_TRY(lexer, token) ((void)0)
+#endif
 
-    // Text containing literal @ (when preceded by word character)
-    // This handles email addresses like user@example.com or mailto:user@example.com
-    // Pattern: [text]word@word[text] where the @ is preceded by a word char
-    // NOTE: Don't match in C# context - email patterns aren't needed in C# code
-    if (valid_symbols[TEXT_WITH_LITERAL_AT] && !in_csharp_context(scanner)) {
-        bool found_literal_at = false;
-        bool last_was_word = false;
-
-        // Scan forward looking for word+@ pattern
-        while (!lexer->eof(lexer) && lexer->lookahead != '<' &&
-               lexer->lookahead != '"' && lexer->lookahead != '\'') {
-
-            if (lexer->lookahead == '@') {
-                if (last_was_word) {
-                    // Found word char followed by @
-                    razor_advance(lexer);  // consume @
-
-                    // Check if followed by letter/digit (domain part)
-                    if (is_email_char(lexer->lookahead)) {
-                        found_literal_at = true;
-                        // Continue consuming the rest
-                        while (is_email_char(lexer->lookahead) ||
-                               lexer->lookahead == '.' ||
-                               lexer->lookahead == '-') {
-                            razor_advance(lexer);
-                        }
-                        lexer->mark_end(lexer);
-                        // Continue scanning in case there are more @ signs
-                        last_was_word = false;
-                        continue;
-                    }
-                }
-                // @ not preceded by word, or not followed by word
-                // Stop here - this @ might be a Razor construct
-                break;
-            }
-
-            last_was_word = is_email_char(lexer->lookahead);
+#ifdef TREE_SITTER_RAZOR_STATS
+typedef struct {
+    TSLexer base;       // Handed to the scanner in place of the parser's lexer
+    TSLexer *inner;     // The parser's lexer
+    uint64_t advanced;  // Characters advanced or skipped during this call
+    unsigned attempt;   // Token being tried, EXTERNAL_TOKEN_COUNT for the C# scanner
+} RazorStatsLexer;
+#endif
+
+// Scan a C# comment starting at its '/'. These are only tokens in C#
+// context, where they are extras.
+static bool scan_csharp_comment(TSLexer *lexer) {
+    razor_advance(lexer);
+    if (lexer->lookahead == '/') {
+        // Single-line comment
+        razor_advance(lexer);
+        while (!lexer->eof(lexer) && lexer->lookahead != '\n' && lexer->lookahead != '\r') {
             razor_advance(lexer);
-
-            if (found_literal_at) {
-                lexer->mark_end(lexer);
-            }
         }
-
-        if (found_literal_at) {
-            lexer->result_symbol = TEXT_WITH_LITERAL_AT;
-            return true;
+        lexer->result_symbol = CSHARP_COMMENT;
+        return true;
+    } else if (lexer->lookahead == '*') {
+        // Multi-line comment
+        razor_advance(lexer);
+        while (!lexer->eof(lexer)) {
+            if (lexer->lookahead == '*') {
+                razor_advance(lexer);
+                if (lexer->lookahead == '/') {
+                    razor_advance(lexer);
+                    lexer->result_symbol = CSHARP_COMMENT;
+                    return true;
+                }
+            } else {
+                razor_advance(lexer);
+            }
         }
-        // No word@word pattern found, don't match
+        // Unterminated comment - still return it
+        lexer->result_symbol = CSHARP_COMMENT;
+        return true;
     }
+    // Just / alone - don't match
+    return false;
+}
 
-    // HTML text content - matches text but stops before keywords like else/catch/finally
-    // This allows the grammar to recognize these keywords after @if/@try blocks
-    // NOTE: Don't match in C# context - HTML text isn't valid inside C# code
-    if (valid_symbols[HTML_TEXT_CONTENT] && !in_csharp_context(scanner)) {
-        bool has_content = false;
-        bool found_keyword = false;
-        bool at_line_start = true;  // Track if we're at the logical start of a line
+// Scan a C# preprocessor directive starting at its '#', up to and including
+// the line break
+static void scan_csharp_preproc(TSLexer *lexer) {
+    razor_advance(lexer);
 
-        while (!lexer->eof(lexer)) {
-            // Stop at HTML/Razor markers
-            if (lexer->lookahead == '<' || lexer->lookahead == '@') {
-                break;
-            }
+    // Consume rest of line (the directive content)
+    while (!lexer->eof(lexer) && lexer->lookahead != '\n' && lexer->lookahead != '\r') {
+        razor_advance(lexer);
+    }
+    // Consume the newline
+    if (!lexer->eof(lexer) && lexer->lookahead == '\r') {
+        razor_advance(lexer);
+    }
+    if (!lexer->eof(lexer) && lexer->lookahead == '\n') {
+        razor_advance(lexer);
+    }
+    lexer->result_symbol = CSHARP_PREPROC;
+}
 
-            // Stop at characters that shouldn't be in text (expression continuations)
-            if (lexer->lookahead == '.' || lexer->lookahead == '[' || lexer->lookahead == '(') {
-                break;
-            }
+// razor_skip_space for error recovery, which also wants to know whether
+// the next character starts its line but for indentation. Returns -1 if a
+// line break was skipped, and otherwise how much indentation was, which
+// the caller compares with get_column only when it has to: that call can
+// read back to the start of the line.
+static int32_t skip_space_counting_indent(TSLexer *lexer) {
+    int32_t indent = 0;
+    while (razor_is_space(lexer->lookahead)) {
+        if (lexer->lookahead == '\n' || lexer->lookahead == '\r') {
+            indent = -1;
+        } else if (indent >= 0) {
+            indent++;
+        }
+        razor_skip(lexer);
+    }
+    return indent;
+}
 
-            // Stop at string delimiters (for directive arguments like @page "/route")
-            if (lexer->lookahead == '"' || lexer->lookahead == '\'') {
-                break;
-            }
+// Scan @{ or @( with the lexer just past the '@'
+static bool scan_context_open(RazorScanner *scanner, TSLexer *lexer, const bool *valid_symbols) {
+    RAZOR_STATS_TRY(lexer, valid_symbols[CSHARP_CODE_BLOCK_START] ? CSHARP_CODE_BLOCK_START
+                                                                  : CSHARP_EXPLICIT_EXPR_START);
+    if (valid_symbols[CSHARP_CODE_BLOCK_START] && lexer->lookahead == '{' &&
+        context_push(scanner, CONTEXT_CSHARP_BRACE)) {
+        razor_advance(lexer);
+        lexer->result_symbol = CSHARP_CODE_BLOCK_START;
+        return true;
+    }
+    if (valid_symbols[CSHARP_EXPLICIT_EXPR_START] && lexer->lookahead == '(' &&
+        context_push(scanner, CONTEXT_CSHARP_PAREN)) {
+        razor_advance(lexer);
+        lexer->result_symbol = CSHARP_EXPLICIT_EXPR_START;
+        return true;
+    }
+    // Not @{ or @( - don't match
+    return false;
+}
 
-            // Track newlines to know when we're at line start
-            if (lexer->lookahead == '\n' || lexer->lookahead == '\r') {
-                razor_advance(lexer);
-                has_content = true;
-                lexer->mark_end(lexer);
-                at_line_start = true;
-                continue;
-            }
+// Scan the identifier after an '@' in markup, with the lexer just past the
+// '@'. A directive keyword is its own token, taken whole; in front of a
+// statement keyword only the '@' is, and the keyword is left to the grammar.
+// Anything else, such as @Model, is an implicit expression for the
+// generated lexer.
+static bool scan_at_keyword(TSLexer *lexer, const bool *valid_symbols) {
+    lexer->mark_end(lexer);
+    RazorKeyword keyword = scan_razor_keyword(lexer);
+
+    if (razor_keyword_is_directive(keyword)) {
+        unsigned token = FIRST_DIRECTIVE_KEYWORD + (keyword - RAZOR_KEYWORD_PAGE);
+        RAZOR_STATS_TRY(lexer, token);
+        if (!valid_symbols[token]) {
+            return false;
+        }
+        lexer->mark_end(lexer);
+        lexer->result_symbol = token;
+        return true;
+    }
 
-            // Whitespace at line start doesn't change at_line_start
-            if (at_line_start && (lexer->lookahead == ' ' || lexer->lookahead == '\t')) {
-                razor_advance(lexer);
-                has_content = true;
-                lexer->mark_end(lexer);
-                continue;
-            }
+    RAZOR_STATS_TRY(lexer, RAZOR_STATEMENT_START);
+    if (valid_symbols[RAZOR_STATEMENT_START] && razor_keyword_starts_statement(lexer, keyword)) {
+        lexer->result_symbol = RAZOR_STATEMENT_START;
+        return true;
+    }
+    return false;
+}
 
-            // Check for keywords only at line start
-            // If we see 'e', 'c', or 'f' at line start, check for else/catch/finally
-            if (at_line_start && (lexer->lookahead == 'e' || lexer->lookahead == 'c' || lexer->lookahead == 'f')) {
-                lexer->mark_end(lexer);
+// External tokens as bits of a mask, for the dispatch in razor_scan
+#define TOKEN_BIT(token) (1u << ((token) - TEXT_WITH_LITERAL_AT))
+
+#define TEXT_TOKENS (TOKEN_BIT(TEXT_WITH_LITERAL_AT) | TOKEN_BIT(HTML_TEXT_CONTENT))
+#define RAW_TEXT_TOKENS \
+    (TOKEN_BIT(SCRIPT_CONTENT) | TOKEN_BIT(STYLE_CONTENT) | TOKEN_BIT(TITLE_CONTENT) | TOKEN_BIT(TEXTAREA_CONTENT))
+#define CSHARP_CONTEXT_TOKENS \
+    (TOKEN_BIT(CSHARP_CONTEXT_CLOSE) | TOKEN_BIT(CSHARP_COMMENT) | TOKEN_BIT(CSHARP_PREPROC))
+#define KEYWORD_TOKENS (TOKEN_BIT(RAZOR_STATEMENT_START) | TOKEN_BIT(FIRST_DIRECTIVE_KEYWORD))
+#define AT_TOKENS                                                                                          \
+    (TOKEN_BIT(RAZOR_COMMENT) | TOKEN_BIT(CSHARP_CODE_BLOCK_START) | TOKEN_BIT(CSHARP_EXPLICIT_EXPR_START) | \
+     KEYWORD_TOKENS)
+
+// Valid Razor tokens as a mask, without the ones the current context rules
+// out: text is never scanned in C# context, and closers, C# comments and
+// directives only are. The directive keywords are only ever valid together,
+// as the alternatives of razor_directive, so the first one's bit stands for
+// all of them.
+static inline uint32_t valid_razor_tokens(RazorScanner *scanner, const bool *valid_symbols) {
+    uint32_t valid = 0;
+    for (unsigned token = TEXT_WITH_LITERAL_AT; token <= FIRST_DIRECTIVE_KEYWORD; token++) {
+        valid |= (uint32_t)valid_symbols[token] << (token - TEXT_WITH_LITERAL_AT);
+    }
+    return valid & (in_csharp_context(scanner) ? ~TEXT_TOKENS : ~CSHARP_CONTEXT_TOKENS);
+}
 
-                // Peek ahead to check for keywords
-                char keyword_buf[8] = {0};
-                int keyword_len = 0;
-                int32_t start_char = lexer->lookahead;
+// Razor tokens that can start with `c`. Raw text can start with anything;
+// the text tokens cannot start at a character that ends them. '.', '[' and
+// '(' end HTML text, but a literal @ search may start there and HTML text
+// picks up where it stopped, so both stay candidates.
+static inline uint32_t razor_token_candidates(int32_t c) {
+    switch (c) {
+        case '@':
+            return AT_TOKENS | RAW_TEXT_TOKENS;
+        case '<':
+            return TOKEN_BIT(HTML_COMMENT) | RAW_TEXT_TOKENS;
+        case '"':
+        case '\'':
+            return RAW_TEXT_TOKENS;
+        case '{':
+            return TOKEN_BIT(RAZOR_BLOCK_OPEN) | TEXT_TOKENS | RAW_TEXT_TOKENS;
+        case '}':
+        case ')':
+            return TOKEN_BIT(CSHARP_CONTEXT_CLOSE) | TEXT_TOKENS | RAW_TEXT_TOKENS;
+        case '/':
+            return TOKEN_BIT(CSHARP_COMMENT) | TEXT_TOKENS | RAW_TEXT_TOKENS;
+        case '#':
+            return TOKEN_BIT(CSHARP_PREPROC) | TEXT_TOKENS | RAW_TEXT_TOKENS;
+        case '.':
+            return TOKEN_BIT(RAZOR_MEMBER_DOT) | TEXT_TOKENS | RAW_TEXT_TOKENS;
+        default:
+            return TEXT_TOKENS | RAW_TEXT_TOKENS;
+    }
+}
 
-                while (keyword_len < 7 && is_identifier_char(lexer->lookahead)) {
-                    keyword_buf[keyword_len++] = (char)lexer->lookahead;
-                    razor_advance(lexer);
-                }
-                keyword_buf[keyword_len] = '\0';
-
-                // Check if we found a keyword followed by whitespace, brace, or paren
-                bool is_keyword = false;
-                if (!is_identifier_char(lexer->lookahead)) {
-                    if (start_char == 'e' && strcmp(keyword_buf, "else") == 0) {
-                        is_keyword = true;
-                    } else if (start_char == 'c' && strcmp(keyword_buf, "catch") == 0) {
-                        is_keyword = true;
-                    } else if (start_char == 'f' && strcmp(keyword_buf, "finally") == 0) {
-                        is_keyword = true;
-                    }
-                }
+static inline bool razor_scan(void *payload, TSLexer *lexer, const bool *valid_symbols) {
+    RazorScanner *scanner = (RazorScanner *)payload;
 
-                if (is_keyword) {
-                    // Stop here - don't consume the keyword
-                    found_keyword = true;
-                    break;
-                }
+    // -------------------------------------------------------------------------
+    // Error recovery
+    // -------------------------------------------------------------------------
 
-                // Not a keyword, the characters we advanced over are content
-                has_content = true;
-                lexer->mark_end(lexer);
-                at_line_start = false;
-                continue;
-            }
+    // During error recovery every token is valid, raw text of every kind
+    // included, which it never is otherwise. Recovery skips tokens without
+    // the scanner knowing, so it can skip the closer of a context it opened
+    // (an unbalanced @{, a '{' in skipped C#), and then everything after is
+    // scanned as C#. Keyword-aware HTML text is only ever valid between
+    // top-level nodes, which no context encloses, so once the parser is back
+    // there any context still open is left over and dropped. Recovery gets
+    // back there sooner at a directive at the start of a line (see below).
+    bool recovering = valid_symbols[SCRIPT_CONTENT] && valid_symbols[STYLE_CONTENT];
+    if (!recovering && valid_symbols[HTML_TEXT_CONTENT] && in_csharp_context(scanner)) {
+        context_reset(scanner);
+    }
 
-            // Any other character - no longer at line start
-            razor_advance(lexer);
-            has_content = true;
-            lexer->mark_end(lexer);
-            at_line_start = false;
-        }
+    uint32_t valid = valid_razor_tokens(scanner, valid_symbols);
 
-        if (has_content) {
-            lexer->result_symbol = HTML_TEXT_CONTENT;
-            return true;
-        }
+    // -------------------------------------------------------------------------
+    // Whitespace
+    // -------------------------------------------------------------------------
 
-        // If we found a keyword immediately (no content), don't match
-        // This lets the grammar try to match the keyword
-        if (found_keyword) {
-            return false;
+    // The scanner runs before extras are skipped. '{' after a Razor statement
+    // and the '}' or ')' closing a C# context may follow whitespace, so it is
+    // skipped once for both. Inside elements, whitespace in front of a
+    // comment is text; between top-level nodes it is an extra and skipped as
+    // well, and keyword-aware HTML text is what tells the two apart. The same
+    // goes for the @ in front of a directive or statement keyword. If no
+    // such token follows, the skipped whitespace is simply left out of
+    // whatever token is scanned instead. Tokens that continue the previous
+    // one must not follow whitespace at all.
+    bool immediate = !razor_is_space(lexer->lookahead);
+    int32_t indent = 0;
+    if ((valid & (TOKEN_BIT(RAZOR_BLOCK_OPEN) | TOKEN_BIT(CSHARP_CONTEXT_CLOSE))) ||
+        ((valid & (TOKEN_BIT(RAZOR_COMMENT) | TOKEN_BIT(HTML_COMMENT) | KEYWORD_TOKENS)) &&
+         valid_symbols[HTML_TEXT_CONTENT])) {
+        if (recovering) {
+            indent = skip_space_counting_indent(lexer);
+        } else {
+            razor_skip_space(lexer);
         }
     }
 
     // -------------------------------------------------------------------------
-    // Context-tracking tokens for C# vs HTML mode
+    // Dispatch on the first character
     // -------------------------------------------------------------------------
 
-    // @{ and @( - enter C# context
-    if ((valid_symbols[CSHARP_CODE_BLOCK_START] || valid_symbols[CSHARP_EXPLICIT_EXPR_START]) &&
-        lexer->lookahead == '@') {
+    // Only the tokens that can start here are tried, so a call with nothing
+    // to scan goes straight to the C# scanner, and nothing is tried after a
+    // search that has already consumed characters of its own.
+    uint32_t candidates = valid & (lexer->eof(lexer) ? RAW_TEXT_TOKENS : razor_token_candidates(lexer->lookahead));
+    if (candidates == 0) {
+        RAZOR_STATS_TRY(lexer, EXTERNAL_TOKEN_COUNT);
+        return tree_sitter_c_sharp_external_scanner_scan(&scanner->csharp, lexer, valid_symbols);
+    }
+
+    // @* *@, @{, @( and @ in front of a directive or statement keyword (HTML
+    // context, where they are Razor transitions)
+    //
+    // Directives only ever start a top-level line, so in error recovery one
+    // there (@code, @section, @page and the rest) ends whatever C# context
+    // was left open: the parser can resume at the directive, and what
+    // follows is scanned as markup again.
+    if (candidates & AT_TOKENS) {
+        bool resync = recovering && in_csharp_context(scanner) &&
+                      (indent < 0 || lexer->get_column(lexer) == (uint32_t)indent);
         razor_advance(lexer);
-        if (valid_symbols[CSHARP_CODE_BLOCK_START] && lexer->lookahead == '{') {
-            razor_advance(lexer);
-            array_push(&scanner->context_stack, CONTEXT_CSHARP_BRACE);
-            lexer->result_symbol = CSHARP_CODE_BLOCK_START;
-            return true;
+        if (candidates & TOKEN_BIT(RAZOR_COMMENT)) {
+            RAZOR_STATS_TRY(lexer, RAZOR_COMMENT);
+            if (scan_razor_comment(lexer)) {
+                lexer->result_symbol = RAZOR_COMMENT;
+                return true;
+            }
         }
-        if (valid_symbols[CSHARP_EXPLICIT_EXPR_START] && lexer->lookahead == '(') {
-            razor_advance(lexer);
-            array_push(&scanner->context_stack, CONTEXT_CSHARP_PAREN);
-            lexer->result_symbol = CSHARP_EXPLICIT_EXPR_START;
-            return true;
+        if (lexer->lookahead == '{' || lexer->lookahead == '(') {
+            return scan_context_open(scanner, lexer, valid_symbols);
         }
-        // Not @{ or @( - don't match
-        return false;
-    }
-
-    // { in Razor block context (after @if, @for, etc.) - enters C# brace context
-    if (valid_symbols[RAZOR_BLOCK_OPEN]) {
-        while (iswspace(lexer->lookahead)) {
-            razor_skip(lexer);
+        if (!(candidates & KEYWORD_TOKENS) || !scan_at_keyword(lexer, valid_symbols)) {
+            return false;
         }
-        if (lexer->lookahead == '{') {
-            razor_advance(lexer);
-            array_push(&scanner->context_stack, CONTEXT_CSHARP_BRACE);
-            lexer->result_symbol = RAZOR_BLOCK_OPEN;
-            return true;
+        if (resync && lexer->result_symbol >= FIRST_DIRECTIVE_KEYWORD) {
+            context_reset(scanner);
         }
+        return true;
     }
 
-    // } or ) that closes C# context
-    if (valid_symbols[CSHARP_CONTEXT_CLOSE] && scanner->context_stack.size > 0) {
-        while (iswspace(lexer->lookahead)) {
-            razor_skip(lexer);
-        }
-
-        ContextType top = scanner->context_stack.contents[scanner->context_stack.size - 1];
-        if ((top == CONTEXT_CSHARP_BRACE && lexer->lookahead == '}') ||
-            (top == CONTEXT_CSHARP_PAREN && lexer->lookahead == ')')) {
-            razor_advance(lexer);
-            array_pop(&scanner->context_stack);
-            lexer->result_symbol = CSHARP_CONTEXT_CLOSE;
+    // '.' of a member access in an implicit expression. Anywhere else the
+    // '.' is text. Of the text tokens only the literal @ search, and HTML
+    // text resuming after it, can take one, and carrying the search on from
+    // past the '.' finds the same thing. Error recovery, where raw text is
+    // valid as well, leaves the '.' to the other tokens.
+    if ((candidates & TOKEN_BIT(RAZOR_MEMBER_DOT)) && immediate && !(candidates & RAW_TEXT_TOKENS)) {
+        RAZOR_STATS_TRY(lexer, RAZOR_MEMBER_DOT);
+        razor_advance(lexer);
+        if (is_identifier_start(lexer->lookahead)) {
+            lexer->result_symbol = RAZOR_MEMBER_DOT;
             return true;
         }
+        if (!(candidates & TOKEN_BIT(TEXT_WITH_LITERAL_AT))) {
+            return false;
+        }
+        candidates &= TEXT_TOKENS;
+    }
+
+    // <!-- -->
+    if (candidates & TOKEN_BIT(HTML_COMMENT)) {
+        RAZOR_STATS_TRY(lexer, HTML_COMMENT);
+        razor_advance(lexer);
+        lexer->result_symbol = HTML_COMMENT;
+        return scan_html_comment(lexer);
     }
 
     // -------------------------------------------------------------------------
-    // Context-aware C# extras (comments, preproc) - only in C# context
+    // Text content (HTML context only)
     // -------------------------------------------------------------------------
 
-    // C# comment - only valid when in C# context
-    if (valid_symbols[CSHARP_COMMENT] && in_csharp_context(scanner)) {
-        if (lexer->lookahead == '/') {
-            razor_advance(lexer);
-            if (lexer->lookahead == '/') {
-                // Single-line comment
-                razor_advance(lexer);
-                while (!lexer->eof(lexer) && lexer->lookahead != '\n' && lexer->lookahead != '\r') {
-                    razor_advance(lexer);
-                }
-                lexer->result_symbol = CSHARP_COMMENT;
+    // Text containing literal @ (when preceded by word character)
+    // This handles email addresses like user@example.com or mailto:user@example.com
+    // Pattern: [text]word@word[text] where the @ is preceded by a word char
+    //
+    // The search stops at '<', a quote or an '@' that does not start an email
+    // domain. All of those also end HTML text, so when the search fails HTML
+    // text only has anything left to scan if it stopped just past an '@'.
+    if (candidates & TEXT_TOKENS) {
+        bool text_resumable = true;
+        if (candidates & TOKEN_BIT(TEXT_WITH_LITERAL_AT)) {
+            RAZOR_STATS_TRY(lexer, TEXT_WITH_LITERAL_AT);
+            if (scan_literal_at(lexer, &text_resumable)) {
+                lexer->result_symbol = TEXT_WITH_LITERAL_AT;
                 return true;
-            } else if (lexer->lookahead == '*') {
-                // Multi-line comment
-                razor_advance(lexer);
-                while (!lexer->eof(lexer)) {
-                    if (lexer->lookahead == '*') {
-                        razor_advance(lexer);
-                        if (lexer->lookahead == '/') {
-                            razor_advance(lexer);
-                            lexer->result_symbol = CSHARP_COMMENT;
-                            return true;
-                        }
-                    } else {
-                        razor_advance(lexer);
-                    }
-                }
-                // Unterminated comment - still return it
-                lexer->result_symbol = CSHARP_COMMENT;
+            }
+        }
+
+        // HTML text content - matches text but stops before keywords like else/catch/finally
+        // This allows the grammar to recognize these keywords after @if/@try blocks
+        if ((candidates & TOKEN_BIT(HTML_TEXT_CONTENT)) && text_resumable) {
+            RAZOR_STATS_TRY(lexer, HTML_TEXT_CONTENT);
+            bool stopped_at_keyword;
+            if (scan_html_text(lexer, true, &stopped_at_keyword)) {
+                lexer->result_symbol = HTML_TEXT_CONTENT;
                 return true;
             }
-            // Just / alone - don't consume
+        }
+
+        // Either search has read characters that any other token would
+        // have to start with, or stopped in front of an else/catch/finally
+        // that the grammar has to see. Only in error recovery, where raw
+        // text is valid too, does scanning carry on from here.
+        candidates &= RAW_TEXT_TOKENS;
+        if (candidates == 0) {
             return false;
         }
     }
 
-    // C# preprocessor directive - only valid when in C# context
-    if (valid_symbols[CSHARP_PREPROC] && in_csharp_context(scanner) && lexer->lookahead == '#') {
+    // { in Razor block context (after @if, @for, etc.) - enters C# brace context
+    if (candidates & TOKEN_BIT(RAZOR_BLOCK_OPEN)) {
+        RAZOR_STATS_TRY(lexer, RAZOR_BLOCK_OPEN);
+        if (!context_push(scanner, CONTEXT_CSHARP_BRACE)) {
+            return false;
+        }
         razor_advance(lexer);
+        lexer->result_symbol = RAZOR_BLOCK_OPEN;
+        return true;
+    }
 
-        // Consume rest of line (the directive content)
-        while (!lexer->eof(lexer) && lexer->lookahead != '\n' && lexer->lookahead != '\r') {
-            razor_advance(lexer);
-        }
-        // Consume the newline
-        if (!lexer->eof(lexer) && lexer->lookahead == '\r') {
-            razor_advance(lexer);
-        }
-        if (!lexer->eof(lexer) && lexer->lookahead == '\n') {
-            razor_advance(lexer);
-        }
-        lexer->result_symbol = CSHARP_PREPROC;
+    // } or ) that closes C# context
+    if ((candidates & TOKEN_BIT(CSHARP_CONTEXT_CLOSE)) &&
+        lexer->lookahead == (context_top(scanner) == CONTEXT_CSHARP_BRACE ? '}' : ')')) {
+        RAZOR_STATS_TRY(lexer, CSHARP_CONTEXT_CLOSE);
+        razor_advance(lexer);
+        context_pop(scanner);
+        lexer->result_symbol = CSHARP_CONTEXT_CLOSE;
+        return true;
+    }
+
+    // C# comment - only valid when in C# context
+    if (candidates & TOKEN_BIT(CSHARP_COMMENT)) {
+        RAZOR_STATS_TRY(lexer, CSHARP_COMMENT);
+        return scan_csharp_comment(lexer);
+    }
+
+    // C# preprocessor directive - only valid when in C# context
+    if (candidates & TOKEN_BIT(CSHARP_PREPROC)) {
+        RAZOR_STATS_TRY(lexer, CSHARP_PREPROC);
+        scan_csharp_preproc(lexer);
         return true;
     }
 
     // -------------------------------------------------------------------------
-    // Script and style content - raw text until closing tag
+    // Script, style, title and textarea content - raw text until closing tag
     // -------------------------------------------------------------------------
 
-    // Script content - scan until </script>
-    if (valid_symbols[SCRIPT_CONTENT]) {
-        // First check if we're immediately at the end tag
-        if (lexer->lookahead == '<') {
-            // Peek to see if this is </script>
-            lexer->mark_end(lexer);
-            razor_advance(lexer);
-            if (lexer->lookahead == '/') {
-                razor_advance(lexer);
-                // Check for 'script' (case insensitive)
-                int32_t c = lexer->lookahead;
-                if (c == 's' || c == 'S') {
-                    // Likely </script> - don't match any content
-                    return false;
-                }
+    for (unsigned i = 0; i < RAW_TEXT_TAG_COUNT; i++) {
+        if (candidates & TOKEN_BIT(SCRIPT_CONTENT + i)) {
+            RAZOR_STATS_TRY(lexer, SCRIPT_CONTENT + i);
+            if (scan_raw_text(lexer, &RAW_TEXT_TAGS[i])) {
+                lexer->result_symbol = SCRIPT_CONTENT + i;
+                return true;
             }
-            // Not </script>, so < is content - but we need to restart
-            // Return false to let the parser try again
             return false;
         }
+    }
 
-        bool has_content = false;
+    // -------------------------------------------------------------------------
+    // Delegate to C# scanner for C# tokens
+    // -------------------------------------------------------------------------
 
-        while (!lexer->eof(lexer)) {
-            // Check for end tag
-            if (lexer->lookahead == '<') {
-                lexer->mark_end(lexer);
-                razor_advance(lexer);
-                if (lexer->lookahead == '/') {
-                    razor_advance(lexer);
-                    // Check for 'script' (case insensitive)
-                    const char *tag = "script";
-                    int i = 0;
-                    bool matches = true;
-                    while (tag[i] && matches) {
-                        int32_t c = lexer->lookahead;
-                        if (c != tag[i] && c != (tag[i] - 32)) { // case insensitive
-                            matches = false;
-                        } else {
-                            razor_advance(lexer);
-                            i++;
-                        }
-                    }
-                    if (matches && i == 6) {
-                        // Found </script - stop before the <
-                        // mark_end was already called at <
-                        break;
-                    }
-                }
-                // Not </script>, continue - the < and / and any other chars are content
-                has_content = true;
-                lexer->mark_end(lexer);
-            } else {
-                razor_advance(lexer);
-                has_content = true;
-                lexer->mark_end(lexer);
-            }
-        }
+    RAZOR_STATS_TRY(lexer, EXTERNAL_TOKEN_COUNT);
+    return tree_sitter_c_sharp_external_scanner_scan(&scanner->csharp, lexer, valid_symbols);
+}
 
-        if (has_content) {
-            lexer->result_symbol = SCRIPT_CONTENT;
-            return true;
-        }
-        return false;
-    }
+#ifndef TREE_SITTER_RAZOR_STATS
 
-    // Style content - scan until </style>
-    if (valid_symbols[STYLE_CONTENT]) {
-        // First check if we're immediately at the end tag
-        if (lexer->lookahead == '<') {
-            lexer->mark_end(lexer);
-            razor_advance(lexer);
-            if (lexer->lookahead == '/') {
-                razor_advance(lexer);
-                int32_t c = lexer->lookahead;
-                if (c == 's' || c == 'S') {
-                    // Likely </style> - don't match any content
-                    return false;
-                }
-            }
-            return false;
-        }
+bool tree_sitter_razor_external_scanner_scan(void *payload, TSLexer *lexer, const bool *valid_symbols) {
+    return razor_scan(payload, lexer, valid_symbols);
+}
 
-        bool has_content = false;
+#endif
 
-        while (!lexer->eof(lexer)) {
-            if (lexer->lookahead == '<') {
-                lexer->mark_end(lexer);
-                razor_advance(lexer);
-                if (lexer->lookahead == '/') {
-                    razor_advance(lexer);
-                    const char *tag = "style";
-                    int i = 0;
-                    bool matches = true;
-                    while (tag[i] && matches) {
-                        int32_t c = lexer->lookahead;
-                        if (c != tag[i] && c != (tag[i] - 32)) {
-                            matches = false;
-                        } else {
-                            razor_advance(lexer);
-                            i++;
-                        }
-                    }
-                    if (matches && i == 5) {
-                        break;
-                    }
-                }
-                has_content = true;
-                lexer->mark_end(lexer);
-            } else {
-                razor_advance(lexer);
-                has_content = true;
-                lexer->mark_end(lexer);
-            }
-        }
+// =============================================================================
+// Statistics
+// =============================================================================
 
-        if (has_content) {
-            lexer->result_symbol = STYLE_CONTENT;
-            return true;
-        }
-        return false;
-    }
+// Built with TREE_SITTER_RAZOR_STATS defined, every scan call is counted
+// against the external tokens (see tree-sitter-razor-stats.h). The scanner
+// then sees a wrapper around the parser's lexer that counts the characters it
+// advances over. Counters are shared by all parsers in the process and
+// updated with relaxed atomics, so batch parsing can be measured too.
+
+// Names of the external tokens, indexed by TokenType, with the last entry
+// standing for calls answered by the C# scanner. Also compiled into tools
+// that include this file and define TREE_SITTER_RAZOR_TOKEN_NAMES (see
+// bench/scanner_profile.c), so there is a single copy to keep in step with
+// the enum.
+#if defined(TREE_SITTER_RAZOR_STATS) || defined(TREE_SITTER_RAZOR_TOKEN_NAMES)
+
+static const char *const EXTERNAL_TOKEN_NAMES[EXTERNAL_TOKEN_COUNT + 1] = {
+    "_optional_semi",
+    "interpolation_regular_start",
+    "interpolation_verbatim_start",
+    "interpolation_raw_start",
+    "interpolation_start_quote",
+    "interpolation_end_quote",
+    "interpolation_open_brace",
+    "interpolation_close_brace",
+    "interpolation_string_content",
+    "raw_string_start",
+    "raw_string_end",
+    "raw_string_content",
+    [TEXT_WITH_LITERAL_AT] = "TEXT_WITH_LITERAL_AT",
+    [HTML_TEXT_CONTENT] = "HTML_TEXT_CONTENT",
+    [CSHARP_CODE_BLOCK_START] = "CSHARP_CODE_BLOCK_START",
+    [CSHARP_EXPLICIT_EXPR_START] = "CSHARP_EXPLICIT_EXPR_START",
+    [RAZOR_BLOCK_OPEN] = "RAZOR_BLOCK_OPEN",
+    [CSHARP_CONTEXT_CLOSE] = "CSHARP_CONTEXT_CLOSE",
+    [CSHARP_COMMENT] = "CSHARP_COMMENT",
+    [CSHARP_PREPROC] = "CSHARP_PREPROC",
+    [SCRIPT_CONTENT] = "SCRIPT_CONTENT",
+    [STYLE_CONTENT] = "STYLE_CONTENT",
+    [TITLE_CONTENT] = "TITLE_CONTENT",
+    [TEXTAREA_CONTENT] = "TEXTAREA_CONTENT",
+    [RAZOR_COMMENT] = "RAZOR_COMMENT",
+    [HTML_COMMENT] = "HTML_COMMENT",
+    [RAZOR_MEMBER_DOT] = "RAZOR_MEMBER_DOT",
+    [RAZOR_STATEMENT_START] = "RAZOR_STATEMENT_START",
+    [PAGE_DIRECTIVE_KEYWORD] = "PAGE_DIRECTIVE_KEYWORD",
+    [MODEL_DIRECTIVE_KEYWORD] = "MODEL_DIRECTIVE_KEYWORD",
+    [INJECT_DIRECTIVE_KEYWORD] = "INJECT_DIRECTIVE_KEYWORD",
+    [INHERITS_DIRECTIVE_KEYWORD] = "INHERITS_DIRECTIVE_KEYWORD",
+    [NAMESPACE_DIRECTIVE_KEYWORD] = "NAMESPACE_DIRECTIVE_KEYWORD",
+    [FUNCTIONS_DIRECTIVE_KEYWORD] = "FUNCTIONS_DIRECTIVE_KEYWORD",
+    [CODE_DIRECTIVE_KEYWORD] = "CODE_DIRECTIVE_KEYWORD",
+    [SECTION_DIRECTIVE_KEYWORD] = "SECTION_DIRECTIVE_KEYWORD",
+    [LAYOUT_DIRECTIVE_KEYWORD] = "LAYOUT_DIRECTIVE_KEYWORD",
+    [ATTRIBUTE_DIRECTIVE_KEYWORD] = "ATTRIBUTE_DIRECTIVE_KEYWORD",
+    [IMPLEMENTS_DIRECTIVE_KEYWORD] = "IMPLEMENTS_DIRECTIVE_KEYWORD",
+    [TYPEPARAM_DIRECTIVE_KEYWORD] = "TYPEPARAM_DIRECTIVE_KEYWORD",
+    [PRESERVEWHITESPACE_DIRECTIVE_KEYWORD] = "PRESERVEWHITESPACE_DIRECTIVE_KEYWORD",
+    [RENDERMODE_DIRECTIVE_KEYWORD] = "RENDERMODE_DIRECTIVE_KEYWORD",
+    [ADDTAGHELPER_DIRECTIVE_KEYWORD] = "ADDTAGHELPER_DIRECTIVE_KEYWORD",
+    [REMOVETAGHELPER_DIRECTIVE_KEYWORD] = "REMOVETAGHELPER_DIRECTIVE_KEYWORD",
+    [TAGHELPERPREFIX_DIRECTIVE_KEYWORD] = "TAGHELPERPREFIX_DIRECTIVE_KEYWORD",
+    [EXTERNAL_TOKEN_COUNT] = "(c_sharp scanner)",
+};
 
-    // Title content - scan until </title>
-    if (valid_symbols[TITLE_CONTENT]) {
-        // First check if we're immediately at the end tag
-        if (lexer->lookahead == '<') {
-            lexer->mark_end(lexer);
-            razor_advance(lexer);
-            if (lexer->lookahead == '/') {
-                razor_advance(lexer);
-                int32_t c = lexer->lookahead;
-                if (c == 't' || c == 'T') {
-                    return false;
-                }
-            }
-            return false;
-        }
+#endif
 
-        bool has_content = false;
+#ifdef TREE_SITTER_RAZOR_STATS
 
-        while (!lexer->eof(lexer)) {
-            if (lexer->lookahead == '<') {
-                lexer->mark_end(lexer);
-                razor_advance(lexer);
-                if (lexer->lookahead == '/') {
-                    razor_advance(lexer);
-                    const char *tag = "title";
-                    int i = 0;
-                    bool matches = true;
-                    while (tag[i] && matches) {
-                        int32_t c = lexer->lookahead;
-                        if (c != tag[i] && c != (tag[i] - 32)) {
-                            matches = false;
-                        } else {
-                            razor_advance(lexer);
-                            i++;
-                        }
-                    }
-                    if (matches && i == 5) {
-                        break;
-                    }
-                }
-                has_content = true;
-                lexer->mark_end(lexer);
-            } else {
-                razor_advance(lexer);
-                has_content = true;
-                lexer->mark_end(lexer);
-            }
-        }
+#include <stdatomic.h>
 
-        if (has_content) {
-            lexer->result_symbol = TITLE_CONTENT;
-            return true;
-        }
-        return false;
-    }
+#include "../bindings/c/tree_sitter/tree-sitter-razor-stats.h"
 
-    // Textarea content - scan until </textarea>
-    if (valid_symbols[TEXTAREA_CONTENT]) {
-        // First check if we're immediately at the end tag
-        if (lexer->lookahead == '<') {
-            lexer->mark_end(lexer);
-            razor_advance(lexer);
-            if (lexer->lookahead == '/') {
-                razor_advance(lexer);
-                int32_t c = lexer->lookahead;
-                if (c == 't' || c == 'T') {
-                    return false;
-                }
-            }
-            return false;
-        }
+typedef struct {
+    atomic_uint_fast64_t calls;
+    atomic_uint_fast64_t successes;
+    atomic_uint_fast64_t advanced;
+    atomic_uint_fast64_t rejections;
+    atomic_uint_fast64_t rejected_advanced;
+} RazorTokenCounters;
 
-        bool has_content = false;
+static RazorTokenCounters token_counters[EXTERNAL_TOKEN_COUNT + 1];
 
-        while (!lexer->eof(lexer)) {
-            if (lexer->lookahead == '<') {
-                lexer->mark_end(lexer);
-                razor_advance(lexer);
-                if (lexer->lookahead == '/') {
-                    razor_advance(lexer);
-                    const char *tag = "textarea";
-                    int i = 0;
-                    bool matches = true;
-                    while (tag[i] && matches) {
-                        int32_t c = lexer->lookahead;
-                        if (c != tag[i] && c != (tag[i] - 32)) {
-                            matches = false;
-                        } else {
-                            razor_advance(lexer);
-                            i++;
-                        }
-                    }
-                    if (matches && i == 8) {
-                        break;
-                    }
-                }
-                has_content = true;
-                lexer->mark_end(lexer);
-            } else {
-                razor_advance(lexer);
-                has_content = true;
-                lexer->mark_end(lexer);
-            }
+static inline void counter_add(atomic_uint_fast64_t *counter, uint64_t value) {
+    atomic_fetch_add_explicit(counter, value, memory_order_relaxed);
+}
+
+static void stats_advance(TSLexer *lexer, bool skip) {
+    RazorStatsLexer *self = (RazorStatsLexer *)lexer;
+    self->inner->advance(self->inner, skip);
+    self->base.lookahead = self->inner->lookahead;
+    self->advanced++;
+}
+
+static void stats_mark_end(TSLexer *lexer) {
+    RazorStatsLexer *self = (RazorStatsLexer *)lexer;
+    self->inner->mark_end(self->inner);
+}
+
+static uint32_t stats_get_column(TSLexer *lexer) {
+    RazorStatsLexer *self = (RazorStatsLexer *)lexer;
+    uint32_t column = self->inner->get_column(self->inner);
+    self->base.lookahead = self->inner->lookahead;
+    return column;
+}
+
+static bool stats_is_at_included_range_start(const TSLexer *lexer) {
+    const RazorStatsLexer *self = (const RazorStatsLexer *)lexer;
+    return self->inner->is_at_included_range_start(self->inner);
+}
+
+static bool stats_eof(const TSLexer *lexer) {
+    const RazorStatsLexer *self = (const RazorStatsLexer *)lexer;
+    return self->inner->eof(self->inner);
+}
+
+// The scanners never log, and a variadic call cannot be forwarded
+static void stats_log(const TSLexer *lexer, const char *format, ...) {
+    (void)lexer;
+    (void)format;
+}
+
+bool tree_sitter_razor_external_scanner_scan(void *payload, TSLexer *lexer, const bool *valid_symbols) {
+    RazorStatsLexer wrapper = {
+        .base =
+            {
+                .lookahead = lexer->lookahead,
+                .advance = stats_advance,
+                .mark_end = stats_mark_end,
+                .get_column = stats_get_column,
+                .is_at_included_range_start = stats_is_at_included_range_start,
+                .eof = stats_eof,
+                .log = stats_log,
+            },
+        .inner = lexer,
+        .attempt = EXTERNAL_TOKEN_COUNT,
+    };
+
+    bool result = razor_scan(payload, &wrapper.base, valid_symbols);
+    lexer->result_symbol = wrapper.base.result_symbol;
+
+    for (unsigned i = 0; i < EXTERNAL_TOKEN_COUNT; i++) {
+        if (valid_symbols[i]) {
+            counter_add(&token_counters[i].calls, 1);
         }
+    }
 
-        if (has_content) {
-            lexer->result_symbol = TEXTAREA_CONTENT;
-            return true;
+    // A call that reaches the C# scanner is also counted as a whole in the
+    // "(c_sharp scanner)" entry
+    RazorTokenCounters *branch = &token_counters[wrapper.attempt];
+    if (wrapper.attempt == EXTERNAL_TOKEN_COUNT) {
+        counter_add(&branch->calls, 1);
+    }
+    if (result) {
+        RazorTokenCounters *counters = &token_counters[wrapper.base.result_symbol];
+        counter_add(&counters->successes, 1);
+        counter_add(&counters->advanced, wrapper.advanced);
+        if (wrapper.attempt == EXTERNAL_TOKEN_COUNT) {
+            counter_add(&branch->successes, 1);
+            counter_add(&branch->advanced, wrapper.advanced);
         }
+    } else {
+        counter_add(&branch->rejections, 1);
+        counter_add(&branch->rejected_advanced, wrapper.advanced);
+    }
+    return result;
+}
+
+bool tree_sitter_razor_stats_read(unsigned token, TSRazorTokenStats *stats) {
+    if (token > EXTERNAL_TOKEN_COUNT) {
         return false;
     }
+    RazorTokenCounters *counters = &token_counters[token];
+    stats->calls = atomic_load_explicit(&counters->calls, memory_order_relaxed);
+    stats->successes = atomic_load_explicit(&counters->successes, memory_order_relaxed);
+    stats->advanced = atomic_load_explicit(&counters->advanced, memory_order_relaxed);
+    stats->rejections = atomic_load_explicit(&counters->rejections, memory_order_relaxed);
+    stats->rejected_advanced = atomic_load_explicit(&counters->rejected_advanced, memory_order_relaxed);
+    return true;
+}
 
-    // -------------------------------------------------------------------------
-    // Delegate to C# scanner for C# tokens
-    // -------------------------------------------------------------------------
+void tree_sitter_razor_stats_reset(void) {
+    for (unsigned i = 0; i <= EXTERNAL_TOKEN_COUNT; i++) {
+        RazorTokenCounters *counters = &token_counters[i];
+        atomic_store_explicit(&counters->calls, 0, memory_order_relaxed);
+        atomic_store_explicit(&counters->successes, 0, memory_order_relaxed);
+        atomic_store_explicit(&counters->advanced, 0, memory_order_relaxed);
+        atomic_store_explicit(&counters->rejections, 0, memory_order_relaxed);
+        atomic_store_explicit(&counters->rejected_advanced, 0, memory_order_relaxed);
+    }
+}
 
-    return tree_sitter_c_sharp_external_scanner_scan(scanner->csharp_scanner, lexer, valid_symbols);
+unsigned tree_sitter_razor_stats_token_count(void) { return EXTERNAL_TOKEN_COUNT + 1; }
+
+const char *tree_sitter_razor_stats_token_name(unsigned token) {
+    return token <= EXTERNAL_TOKEN_COUNT ? EXTERNAL_TOKEN_NAMES[token] : NULL;
 }
+
+#endif // TREE_SITTER_RAZOR_STATS
@@ -0,0 +1,320 @@
+// Generated by script/generate-unicode.js - do not edit by hand.
+// Unicode 16.0: Lu, Ll, Lt, Lm, Lo, Nd
+
+#ifndef TREE_SITTER_RAZOR_UNICODE_H_
+#define TREE_SITTER_RAZOR_UNICODE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define UNICODE_WORD_BLOCK_SHIFT 7
+#define UNICODE_WORD_BLOCK_COUNT 1608
+
+static const uint8_t UNICODE_WORD_INDEX[UNICODE_WORD_BLOCK_COUNT] = {
+    0, 1, 2, 2, 2, 3, 4, 5, 2, 6, 7, 8, 9, 10, 11, 12,
+    13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28,
+    29, 30, 2, 2, 31, 32, 33, 34, 35, 2, 2, 2, 36, 37, 38, 39,
+    40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 2, 50, 2, 2, 51, 52,
+    53, 54, 55, 56, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 2, 58, 59, 60, 61, 57, 57, 57,
+    62, 63, 64, 65, 57, 57, 57, 57, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 50, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 66, 2, 2, 67, 68, 69, 70,
+    71, 72, 73, 74, 75, 76, 77, 78, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 79,
+    57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+    57, 57, 2, 2, 80, 81, 82, 83, 2, 2, 84, 85, 86, 87, 88, 89,
+    90, 91, 57, 57, 57, 92, 93, 94, 2, 95, 96, 97, 2, 2, 98, 99,
+    100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 57, 112, 113, 114,
+    115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 57, 125, 126, 127, 128, 57,
+    129, 130, 131, 132, 133, 134, 57, 135, 136, 137, 138, 139, 57, 140, 141, 142,
+    2, 2, 2, 2, 2, 2, 2, 143, 57, 2, 144, 57, 57, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 145,
+    2, 2, 2, 2, 2, 2, 2, 2, 146, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 91, 2, 2, 2, 2, 147, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+    57, 57, 148, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+    2, 2, 2, 2, 149, 150, 151, 137, 57, 57, 152, 57, 153, 57, 154, 155,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 156,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 157, 158, 57, 57, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 159,
+    2, 2, 160, 2, 2, 161, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 162, 163, 57, 57, 57, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 57, 164, 57, 57, 57, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 165, 166, 167, 2, 2, 168, 169, 170,
+    57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 171, 57,
+    172, 57, 173, 57, 57, 174, 57, 57, 57, 175, 57, 176, 57, 57, 57, 177,
+    2, 178, 179, 57, 57, 57, 57, 57, 57, 57, 57, 57, 180, 181, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 164, 57, 57, 57, 57, 57, 57, 57, 57,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 182, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 183, 2,
+    184, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 185, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 186, 2, 2, 2, 2, 187, 57, 57, 57,
+    57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+    2, 2, 2, 2, 188, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57, 57,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 189, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 190,
+};
+
+static const uint32_t UNICODE_WORD_BITS[191][4] = {
+    {0x00000000, 0x03FF0000, 0x07FFFFFE, 0x07FFFFFE},
+    {0x00000000, 0x04200400, 0xFF7FFFFF, 0xFF7FFFFF},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0x0003FFC3, 0x0000501F},
+    {0x00000000, 0x00000000, 0x00000000, 0xBCDF0000},
+    {0xFFFFD740, 0xFFFFFFFB, 0xFFFFFFFF, 0xFFBFFFFF},
+    {0xFFFFFC03, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF},
+    {0xFFFFFFFF, 0xFFFEFFFF, 0x027FFFFF, 0xFFFFFFFF},
+    {0x000001FF, 0x00000000, 0xFFFF0000, 0x000787FF},
+    {0x00000000, 0xFFFFFFFF, 0x000007FF, 0xFFFEC3FF},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0x002FFFFF, 0x9FFFC060},
+    {0xFFFD0000, 0x0000FFFF, 0xFFFFE000, 0xFFFFFFFF},
+    {0xFFFFFFFF, 0x0002003F, 0xFFFFFFFF, 0x043007FF},
+    {0x043FFFFF, 0x00000110, 0x01FFFFFF, 0xFFFF07FF},
+    {0x00007EFF, 0xFFFFFFFF, 0x000003FF, 0x00000000},
+    {0xFFFFFFF0, 0x23FFFFFF, 0xFF010000, 0xFFFEFFC3},
+    {0xFFF99FE1, 0x23C5FDFF, 0xB0004000, 0x1003FFC3},
+    {0xFFF987E0, 0x036DFDFF, 0x5E000000, 0x001CFFC0},
+    {0xFFFBBFE0, 0x23EDFDFF, 0x00010000, 0x0200FFC3},
+    {0xFFF99FE0, 0x23EDFDFF, 0xB0000000, 0x0002FFC3},
+    {0xD63DC7E8, 0x03FFC718, 0x00010000, 0x0000FFC0},
+    {0xFFFDDFE0, 0x23FFFDFF, 0x27000000, 0x0000FFC3},
+    {0xFFFDDFE1, 0x23EFFDFF, 0x60000000, 0x0006FFC3},
+    {0xFFFDDFF0, 0x27FFFFFF, 0x80704000, 0xFC00FFC3},
+    {0xFC7FFFE0, 0x2FFBFFFF, 0x0000007F, 0x0000FFC0},
+    {0xFFFFFFFE, 0x000DFFFF, 0x03FF007F, 0x00000000},
+    {0xFFFFF7D6, 0x200DFFAF, 0xF3FF005F, 0x00000000},
+    {0x00000001, 0x000003FF, 0xFFFFFEFF, 0x00001FFF},
+    {0x00001F00, 0x00000000, 0x00000000, 0x00000000},
+    {0xFFFFFFFF, 0x800007FF, 0x3C3F03FF, 0xFFE1C062},
+    {0x03FF4003, 0xFFFFFFFF, 0xFFFF20BF, 0xF7FFFFFF},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0x3D7F3DFF, 0xFFFFFFFF},
+    {0xFFFF3DFF, 0x7F3DFFFF, 0xFF7FFF3D, 0xFFFFFFFF},
+    {0xFF3DFFFF, 0xFFFFFFFF, 0x07FFFFFF, 0x00000000},
+    {0x0000FFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x3F3FFFFF},
+    {0xFFFFFFFE, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFF9FFF},
+    {0x07FFFFFE, 0xFFFFFFFF, 0xFFFFFFFF, 0x01FE07FF},
+    {0x8003FFFF, 0x0003FFFF, 0x0003FFFF, 0x0001DFFF},
+    {0xFFFFFFFF, 0x000FFFFF, 0x10800000, 0x000003FF},
+    {0x03FF0000, 0xFFFFFFFF, 0xFFFFFFFF, 0x01FFFFFF},
+    {0xFFFFFF9F, 0xFFFF05FF, 0xFFFFFFFF, 0x003FFFFF},
+    {0x7FFFFFFF, 0x00000000, 0xFFFFFFC0, 0x001F3FFF},
+    {0xFFFFFFFF, 0xFFFF0FFF, 0x03FF03FF, 0x00000000},
+    {0x007FFFFF, 0xFFFFFFFF, 0x001FFFFF, 0x00000000},
+    {0x03FF03FF, 0x00000080, 0x00000000, 0x00000000},
+    {0xFFFFFFE0, 0x000FFFFF, 0x03FF1FE0, 0x00000000},
+    {0xFFFFFFF8, 0xFFFFC001, 0xFFFFFFFF, 0x0000003F},
+    {0xFFFFFFFF, 0x0000000F, 0xFFFFE3FF, 0x3FFFFFFF},
+    {0xFFFF07FF, 0xE7FFFFFF, 0x00000000, 0x046FDE00},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0x00000000},
+    {0x3F3FFFFF, 0xFFFFFFFF, 0xAAFF3F3F, 0x3FFFFFFF},
+    {0xFFFFFFFF, 0x5FDFFFFF, 0x0FCF1FDC, 0x1FDC1FFF},
+    {0x00000000, 0x00000000, 0x00000000, 0x80020000},
+    {0x1FFF0000, 0x00000000, 0x00000000, 0x00000000},
+    {0x3E2FFC84, 0xF3FFBD50, 0x000043E0, 0x00000000},
+    {0x00000018, 0x00000000, 0x00000000, 0x00000000},
+    {0x00000000, 0x00000000, 0x00000000, 0x00000000},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x000C781F},
+    {0xFFFFFFFF, 0xFFFF20BF, 0xFFFFFFFF, 0x000080FF},
+    {0x007FFFFF, 0x7F7F7F7F, 0x7F7F7F7F, 0x00000000},
+    {0x00000000, 0x00008000, 0x00000000, 0x00000000},
+    {0x00000060, 0x183E0000, 0xFFFFFFFE, 0xFFFFFFFF},
+    {0xE07FFFFF, 0xFFFFFFFE, 0xFFFFFFFF, 0xF7FFFFFF},
+    {0xFFFFFFE0, 0xFFFEFFFF, 0xFFFFFFFF, 0xFFFFFFFF},
+    {0x00007FFF, 0xFFFFFFFF, 0x00000000, 0xFFFF0000},
+    {0x00001FFF, 0x00000000, 0xFFFF0000, 0x3FFFFFFF},
+    {0xFFFF1FFF, 0x00000FFF, 0xFFFFFFFF, 0x80007FFF},
+    {0x3FFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x0000003F},
+    {0xFF800000, 0xFFFFFFFC, 0xFFFFFFFF, 0xFFFFFFFF},
+    {0xFFFFF9FF, 0xFFFFFFFF, 0x1FEB3FFF, 0xFFFC0000},
+    {0xFFFFF7BB, 0x00000007, 0xFFFFFFFF, 0x000FFFFF},
+    {0xFFFFFFFC, 0x000FFFFF, 0x03FF0000, 0x68FC0000},
+    {0xFFFFFFFF, 0xFFFF003F, 0x0000007F, 0x1FFFFFFF},
+    {0xFFFFFFF0, 0x0007FFFF, 0x03FF8000, 0x7FFFFFDF},
+    {0xFFFFFFFF, 0x000001FF, 0x03FF0FF7, 0xC47FFFFF},
+    {0xFFFFFFFF, 0x3E62FFFF, 0x38000005, 0x001C07FF},
+    {0x007E7E7E, 0xFFFF7F7F, 0xF7FFFFFF, 0xFFFF03FF},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x03FF0007},
+    {0xFFFFFFFF, 0xFFFF000F, 0xFFFFF87F, 0x0FFFFFFF},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFF3FFF},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0x03FFFFFF, 0x00000000},
+    {0xA0F8007F, 0x5F7FFDFF, 0xFFFFFFDB, 0xFFFFFFFF},
+    {0xFFFFFFFF, 0x0003FFFF, 0xFFF80000, 0xFFFFFFFF},
+    {0xFFFFFFFF, 0x3FFFFFFF, 0xFFFF0000, 0xFFFFFFFF},
+    {0xFFFCFFFF, 0xFFFFFFFF, 0x000000FF, 0x0FFF0000},
+    {0x00000000, 0x00000000, 0x00000000, 0xFFDF0000},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x1FFFFFFF},
+    {0x03FF0000, 0x07FFFFFE, 0x07FFFFFE, 0xFFFFFFC0},
+    {0xFFFFFFFF, 0x7FFFFFFF, 0x1CFCFCFC, 0x00000000},
+    {0xFFFFEFFF, 0xB7FFFF7F, 0x3FFF3FFF, 0x00000000},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x07FFFFFF},
+    {0x1FFFFFFF, 0xFFFFFFFF, 0x0001FFFF, 0x00000000},
+    {0xFFFFFFFF, 0xFFFFE000, 0xFFFF03FD, 0x003FFFFF},
+    {0x3FFFFFFF, 0xFFFFFFFF, 0x0000FF0F, 0x00000000},
+    {0x3FFFFFFF, 0xFFFF03FF, 0xFF0FFFFF, 0x0FFFFFFF},
+    {0xFFFFFFFF, 0xFFFF00FF, 0xFFFFFFFF, 0xF7FF000F},
+    {0xFFB7F7FF, 0x1BFBFFFB, 0xFFFFFFFF, 0x000FFFFF},
+    {0xFFFFFFFF, 0x007FFFFF, 0x003FFFFF, 0x000000FF},
+    {0xFFFFFFBF, 0x07FDFFFF, 0x00000000, 0x00000000},
+    {0xFFFFFD3F, 0x91BFFFFF, 0x003FFFFF, 0x007FFFFF},
+    {0x7FFFFFFF, 0x00000000, 0x00000000, 0x0037FFFF},
+    {0x003FFFFF, 0x03FFFFFF, 0x00000000, 0x00000000},
+    {0xFFFFFFFF, 0xC0FFFFFF, 0x00000000, 0x00000000},
+    {0xFEEF0001, 0x003FFFFF, 0x00000000, 0x1FFFFFFF},
+    {0x1FFFFFFF, 0x00000000, 0xFFFFFEFF, 0x0000001F},
+    {0xFFFFFFFF, 0x003FFFFF, 0x003FFFFF, 0x0007FFFF},
+    {0x0003FFFF, 0x00000000, 0x00000000, 0x00000000},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0x000001FF, 0x00000000},
+    {0xFFFFFFFF, 0x0007FFFF, 0xFFFFFFFF, 0x0007FFFF},
+    {0xFFFFFFFF, 0x03FF000F, 0xFFFFFFFF, 0xFFFF803F},
+    {0x0000003F, 0x00000000, 0x00000000, 0x00000000},
+    {0xFFFFFFFF, 0x000303FF, 0x0000001C, 0x00000000},
+    {0x1FFFFFFF, 0xFFFF0080, 0x0000003F, 0xFFFF0000},
+    {0x00000003, 0xFFFF0000, 0x0000001F, 0x007FFFFF},
+    {0xFFFFFFF8, 0x00FFFFFF, 0x00000000, 0x0026FFC0},
+    {0xFFFFFFF8, 0x0000FFFF, 0xFFFF0000, 0x03FF01FF},
+    {0xFFFFFFF8, 0xFFC0007F, 0xFFFF0090, 0x0047FFFF},
+    {0xFFFFFFF8, 0x0007FFFF, 0x17FF001E, 0x00000000},
+    {0xFFFBFFFF, 0x80000FFF, 0x00000001, 0x00000000},
+    {0xBFFFBD7F, 0xFFFF01FF, 0x7FFFFFFF, 0x03FF0000},
+    {0xFFF99FE0, 0x23EDFDFF, 0xE0010000, 0x00000003},
+    {0xFFFF4BFF, 0x00BFFFFF, 0x000A0000, 0x00000000},
+    {0xFFFFFFFF, 0x001FFFFF, 0x83FF0780, 0x00000003},
+    {0xFFFFFFFF, 0x0000FFFF, 0x03FF00B0, 0x00000000},
+    {0xFFFFFFFF, 0x00007FFF, 0x0F000000, 0x00000000},
+    {0xFFFFFFFF, 0x0000FFFF, 0x03FF0010, 0x00000000},
+    {0xFFFFFFFF, 0x010007FF, 0xFFFF03FF, 0x0000000F},
+    {0x07FFFFFF, 0x03FF0000, 0x0000007F, 0x00000000},
+    {0xFFFFFFFF, 0x00000FFF, 0x00000000, 0x00000000},
+    {0x00000000, 0xFFFFFFFF, 0xFFFFFFFF, 0x800003FF},
+    {0xFF6FF27F, 0x8000FFFF, 0x03FF0002, 0x00000000},
+    {0x00000000, 0xFFFFFCFF, 0x0001FFFF, 0x0000000A},
+    {0xFFFFF801, 0x0407FFFF, 0xF0010000, 0xFFFFFFFF},
+    {0x200003FF, 0xFFFF0000, 0xFFFFFFFF, 0x01FFFFFF},
+    {0x00000000, 0x00000000, 0xFFFFFFFF, 0x03FF0001},
+    {0xFFFFFDFF, 0x00007FFF, 0x03FF0001, 0xFFFC0000},
+    {0x0000FFFF, 0x00000000, 0x00000000, 0x00000000},
+    {0xFFFFFB7F, 0x0001FFFF, 0x03FF0040, 0xFFFFFDBF},
+    {0x010003FF, 0x000003FF, 0x00000000, 0x00000000},
+    {0x00000000, 0x00000000, 0x00000000, 0x0007FFFF},
+    {0xFFFDFFF4, 0x000FFFFF, 0x03FF0000, 0x00000000},
+    {0x00000000, 0x00010000, 0x00000000, 0x00000000},
+    {0x03FFFFFF, 0x00000000, 0x00000000, 0x00000000},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0x0000000F, 0x00000000},
+    {0xFFFF0000, 0xFFFFFFFF, 0xFFFFFFFF, 0x0001FFFF},
+    {0xFFFFFFFF, 0x0000FFFF, 0x0000007E, 0xFFFFFFFF},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0x0000007F, 0x00000000},
+    {0x3FFFFFFF, 0x03FF0000, 0x00000000, 0x00000000},
+    {0xFFFFFFFF, 0x01FFFFFF, 0x7FFFFFFF, 0xFFFF03FF},
+    {0xFFFFFFFF, 0x7FFFFFFF, 0xFFFF03FF, 0x00003FFF},
+    {0xFFFFFFFF, 0x0000FFFF, 0x03FF000F, 0xE0FFFFF8},
+    {0x00000000, 0x00000000, 0xFFFFFFFF, 0x03FF1FFF},
+    {0x00000000, 0x00000000, 0xFFFFFFFF, 0xFFFFFFFF},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0x000107FF, 0x00000000},
+    {0xFFF80000, 0x00000000, 0x00000000, 0x0000000B},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00FFFFFF},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0x003FFFFF, 0x80000000},
+    {0x000001FF, 0x00000000, 0x00000000, 0x00000000},
+    {0x00000000, 0x00000000, 0x00000000, 0x6FEF0000},
+    {0xFFFFFFFF, 0x00040007, 0x00270000, 0xFFFF00F0},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x0FFFFFFF},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x1FFF07FF},
+    {0x03FF01FF, 0x00000000, 0x00000000, 0x00000000},
+    {0x00000000, 0x00000000, 0x00000000, 0x03FF0000},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0xFFDFFFFF, 0xFFFFFFFF},
+    {0xDFFFFFFF, 0xEBFFDE64, 0xFFFFFFEF, 0xFFFFFFFF},
+    {0xDFDFE7BF, 0x7BFFFFFF, 0xFFFDFC5F, 0xFFFFFFFF},
+    {0xFFFFFFFF, 0xFFFFFF3F, 0xF7FFFFFD, 0xF7FFFFFF},
+    {0xFFDFFFFF, 0xFFDFFFFF, 0xFFFF7FFF, 0xFFFF7FFF},
+    {0xFFFFFDFF, 0xFFFFFDFF, 0xFFFFCFF7, 0xFFFFFFFF},
+    {0x7FFFFFFF, 0x000007E0, 0x00000000, 0x00000000},
+    {0x00000000, 0xFFFF0000, 0xFFFFFFFF, 0x00003FFF},
+    {0xFFFFFFFF, 0x3F801FFF, 0x000043FF, 0x00000000},
+    {0xFFFF0000, 0x00003FFF, 0xFFFFFFFF, 0x03FF0FFF},
+    {0x00000000, 0x00000000, 0xFFFF0000, 0x03FF0FFF},
+    {0x00000000, 0x00000000, 0xFFFF0000, 0x07FF3FFF},
+    {0x00000000, 0x00000000, 0x00000000, 0x7FFF6F7F},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0x0000001F, 0x00000000},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0x03FF080F, 0x00000000},
+    {0xFFFFFFEF, 0x0AF7FE96, 0xAA96EA84, 0x5EF7F796},
+    {0x0FFFFBFF, 0x0FFFFBEE, 0x00000000, 0x00000000},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000},
+    {0xFFFFFFFF, 0x03FFFFFF, 0xFFFFFFFF, 0xFFFFFFFF},
+    {0x3FFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF},
+    {0xFFFFFFFF, 0xFFFF0003, 0xFFFFFFFF, 0xFFFFFFFF},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFF0001},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0x3FFFFFFF, 0x00000000},
+    {0x3FFFFFFF, 0x00000000, 0x00000000, 0x00000000},
+    {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFF07FF, 0xFFFFFFFF},
+    {0xFFFFFFFF, 0x0000FFFF, 0x00000000, 0x00000000},
+};
+
+// Whether c is a letter or decimal digit
+static inline bool unicode_is_word_char(int32_t c) {
+    if (c < 0 || (c >> UNICODE_WORD_BLOCK_SHIFT) >= UNICODE_WORD_BLOCK_COUNT) {
+        return false;
+    }
+    const uint32_t *block = UNICODE_WORD_BITS[UNICODE_WORD_INDEX[c >> UNICODE_WORD_BLOCK_SHIFT]];
+    return (block[(c >> 5) & 3] >> (c & 31)) & 1;
+}
+
+#endif // TREE_SITTER_RAZOR_UNICODE_H_